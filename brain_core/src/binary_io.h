@@ -0,0 +1,71 @@
+#pragma once
+#include <istream>
+#include <ostream>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <cstdint>
+
+// Minimale Binär-Serialisierung für Checkpoints (gleiche Maschine / gleicher Build).
+// Nur trivial kopierbare Typen und Vektoren davon.
+namespace bio {
+
+template <class T>
+void put(std::ostream& o, const T& v) {
+    static_assert(std::is_trivially_copyable<T>::value, "POD erwartet");
+    o.write(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+
+template <class T>
+void get(std::istream& i, T& v) {
+    static_assert(std::is_trivially_copyable<T>::value, "POD erwartet");
+    if (!i.read(reinterpret_cast<char*>(&v), sizeof(T)))
+        throw std::runtime_error("Checkpoint: Datei zu kurz");
+}
+
+template <class T, class A>
+void put_vec(std::ostream& o, const std::vector<T, A>& v) {
+    put<uint64_t>(o, v.size());
+    if (!v.empty()) o.write(reinterpret_cast<const char*>(v.data()), sizeof(T) * v.size());
+}
+
+template <class T, class A>
+void get_vec(std::istream& i, std::vector<T, A>& v) {
+    uint64_t n = 0;
+    get(i, n);
+    v.resize(n);
+    if (n && !i.read(reinterpret_cast<char*>(v.data()), sizeof(T) * n))
+        throw std::runtime_error("Checkpoint: Datei zu kurz");
+}
+
+inline void put_str(std::ostream& o, const std::string& s) {
+    put<uint64_t>(o, s.size());
+    o.write(s.data(), s.size());
+}
+
+inline void get_str(std::istream& i, std::string& s) {
+    uint64_t n = 0;
+    get(i, n);
+    s.resize(n);
+    if (n && !i.read(&s[0], n)) throw std::runtime_error("Checkpoint: Datei zu kurz");
+}
+
+// Zustand von std::mt19937 & Co. (Text-Repräsentation laut Standard)
+template <class Engine>
+void put_rng(std::ostream& o, const Engine& e) {
+    std::ostringstream ss;
+    ss << e;
+    put_str(o, ss.str());
+}
+
+template <class Engine>
+void get_rng(std::istream& i, Engine& e) {
+    std::string s;
+    get_str(i, s);
+    std::istringstream ss(s);
+    ss >> e;
+}
+
+} // namespace bio
@@ -0,0 +1,279 @@
+#include "checkpoint.h"
+#include "net.h"
+#include "binary_io.h"
+#include <fstream>
+#include <cstdio>
+#include <algorithm>
+
+namespace {
+
+constexpr uint32_t kMagic   = 0x4B435242;  // "BRCK"
+constexpr uint32_t kVersion = 9;
+
+void put_rows(std::ostream& o, const RowSpans& r) {
+    bio::put_vec(o, r.start);
+    bio::put_vec(o, r.len);
+    bio::put_vec(o, r.cap);
+    bio::put<uint64_t>(o, r.used);
+    bio::put<uint64_t>(o, r.live);
+    bio::put<uint64_t>(o, r.garbage);
+    bio::put_vec(o, r.by_start);       // laufende Kompaktierung mitnehmen
+    bio::put(o, r.compacting);
+    bio::put<uint64_t>(o, r.cursor);
+    bio::put<uint64_t>(o, r.write);
+    bio::put_vec(o, r.packed);
+}
+
+void get_rows(std::istream& i, RowSpans& r) {
+    bio::get_vec(i, r.start);
+    bio::get_vec(i, r.len);
+    bio::get_vec(i, r.cap);
+    uint64_t v = 0;
+    bio::get(i, v); r.used = v;
+    bio::get(i, v); r.live = v;
+    bio::get(i, v); r.garbage = v;
+    bio::get_vec(i, r.by_start);
+    bio::get(i, r.compacting);
+    bio::get(i, v); r.cursor = v;
+    bio::get(i, v); r.write = v;
+    bio::get_vec(i, r.packed);
+}
+
+void put_store(std::ostream& o, const SynapseStore& s) {
+    bio::put(o, s.scale_bound);
+    put_rows(o, s.rows);
+    bio::put_vec(o, s.target);
+    bio::put_vec(o, s.w32);
+    bio::put_vec(o, s.w16);
+    bio::put_vec(o, s.w8);
+    bio::put_vec(o, s.block_scale);
+    put_rows(o, s.cols);
+    bio::put_vec(o, s.in_pre);
+    bio::put_vec(o, s.in_syn);
+    bio::put_vec(o, s.csc_pos);
+}
+
+void get_store(std::istream& i, SynapseStore& s) {
+    bio::get(i, s.scale_bound);
+    get_rows(i, s.rows);
+    bio::get_vec(i, s.target);
+    bio::get_vec(i, s.w32);
+    bio::get_vec(i, s.w16);
+    bio::get_vec(i, s.w8);
+    bio::get_vec(i, s.block_scale);
+    get_rows(i, s.cols);
+    bio::get_vec(i, s.in_pre);
+    bio::get_vec(i, s.in_syn);
+    bio::get_vec(i, s.csc_pos);
+}
+
+// FNV-1a über rohe Bytes
+struct Fnv {
+    uint64_t h = 1469598103934665603ull;
+    void bytes(const void* p, size_t n) {
+        const auto* c = static_cast<const unsigned char*>(p);
+        for (size_t k = 0; k < n; ++k) { h ^= c[k]; h *= 1099511628211ull; }
+    }
+    template <class T, class A> void vec(const std::vector<T, A>& v) { bytes(v.data(), v.size() * sizeof(T)); }
+    template <class T> void pod(const T& v) { bytes(&v, sizeof(T)); }
+};
+
+} // namespace
+
+void save_checkpoint(const Net& net, const std::string& path) {
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream o(tmp, std::ios::binary | std::ios::trunc);
+        if (!o) throw std::runtime_error("Checkpoint: kann " + tmp + " nicht schreiben");
+
+        bio::put(o, kMagic);
+        bio::put(o, kVersion);
+        bio::put<int32_t>(o, net.neu.N);
+        bio::put(o, net.engine);
+        bio::put(o, net.syn.fmt);
+        bio::put<uint64_t>(o, net.n_procedural);
+
+        // Net
+        bio::put(o, net.tick);
+        bio::put_rng(o, net.rng);
+        net.stimuli.save(o);
+        bio::put_vec(o, net.pre_trace);
+        bio::put_vec(o, net.post_trace);
+        bio::put_vec(o, net.trace_tick);
+        bio::put(o, net.prune_cursor);
+        bio::put(o, net.n_pruned);
+        bio::put(o, net.n_grown);
+        bio::put(o, net.n_compactions);
+
+        // Neuronen
+        const Neurons& n = net.neu;
+        bio::put_vec(o, n.V);
+        bio::put_vec(o, n.Vth);
+        bio::put_vec(o, n.Vrest);
+        bio::put_vec(o, n.Vreset);
+        bio::put_vec(o, n.ref_left);
+        bio::put_vec(o, n.Isyn);
+        bio::put_vec(o, n.spikes);
+        bio::put(o, n.tau_m);
+        bio::put(o, n.tref);
+        bio::put(o, n.vth_shift);
+        bio::put(o, n.prop);
+        bio::put<uint64_t>(o, n.blocks.size());
+        for (const auto& b : n.blocks) {
+            bio::put(o, b.model);
+            bio::put<int32_t>(o, b.begin);
+            bio::put<int32_t>(o, b.end);
+            bio::put_vec(o, b.aux);
+        }
+
+        // Hormone
+        const HormoneSystem& H = net.H;
+        bio::put(o, H.current);
+        bio::put(o, H.target);
+        bio::put(o, H.event_timer);
+        bio::put(o, H.drive_dopamine);
+        bio::put(o, H.drive_cortisol);
+        bio::put(o, H.drive_adrenaline);
+        bio::put_rng(o, H.rng);
+
+        // Synapsen (Topologie kann sich durch strukturelle Plastizität geändert haben)
+        put_store(o, net.syn);
+        put_store(o, net.syn_static);
+
+        // Drei-Faktor-Lernen: offene Traces (alle Shards hintereinander)
+        bio::put(o, net.pending_reward);
+        bio::put(o, net.n_rewards);
+        bio::put<uint64_t>(o, net.n_eligible());
+        for (const auto& el : net.elig)
+            for (const auto& x : el.entries()) bio::put(o, x);
+
+        net.dq.save(o);
+        net.readout.save(o);
+        if (net.engine == Engine::Event) net.ev.save(o);
+
+        if (!o) throw std::runtime_error("Checkpoint: Schreibfehler in " + tmp);
+    }
+    // erst vollständig schreiben, dann umbenennen: kein halber Checkpoint auf der Platte
+    if (std::rename(tmp.c_str(), path.c_str()) != 0)
+        throw std::runtime_error("Checkpoint: kann " + path + " nicht anlegen");
+}
+
+void load_checkpoint(Net& net, const std::string& path) {
+    std::ifstream i(path, std::ios::binary);
+    if (!i) throw std::runtime_error("Checkpoint nicht gefunden: " + path);
+
+    uint32_t magic = 0, version = 0;
+    int32_t  N = 0;
+    Engine   engine;
+    WeightFormat fmt;
+    bio::get(i, magic);
+    bio::get(i, version);
+    if (magic != kMagic || version != kVersion)
+        throw std::runtime_error("Checkpoint: unbekanntes Format");
+    bio::get(i, N);
+    bio::get(i, engine);
+    bio::get(i, fmt);
+    uint64_t n_proc = 0;
+    bio::get(i, n_proc);
+    if (N != net.neu.N || engine != net.engine || fmt != net.syn.fmt || n_proc != net.n_procedural)
+        throw std::runtime_error("Checkpoint passt nicht zum Netz (N / Engine / Gewichtsformat / prozedurale Synapsen)");
+
+    bio::get(i, net.tick);
+    bio::get_rng(i, net.rng);
+    net.stimuli.load(i);
+    bio::get_vec(i, net.pre_trace);
+    bio::get_vec(i, net.post_trace);
+    bio::get_vec(i, net.trace_tick);
+    bio::get(i, net.prune_cursor);
+    bio::get(i, net.n_pruned);
+    bio::get(i, net.n_grown);
+    bio::get(i, net.n_compactions);
+
+    Neurons& n = net.neu;
+    bio::get_vec(i, n.V);
+    bio::get_vec(i, n.Vth);
+    bio::get_vec(i, n.Vrest);
+    bio::get_vec(i, n.Vreset);
+    bio::get_vec(i, n.ref_left);
+    bio::get_vec(i, n.Isyn);
+    std::vector<int> spikes;
+    bio::get_vec(i, spikes);
+    n.set_spikes(spikes);
+    bio::get(i, n.tau_m);
+    bio::get(i, n.tref);
+    bio::get(i, n.vth_shift);
+    bio::get(i, n.prop);
+    uint64_t n_blocks = 0;
+    bio::get(i, n_blocks);
+    if (n_blocks != n.blocks.size()) throw std::runtime_error("Checkpoint passt nicht zum Netz (Neuronen-Modelle)");
+    for (auto& b : n.blocks) {
+        NeuronModel m;
+        int32_t begin = 0, end = 0;
+        bio::get(i, m);
+        bio::get(i, begin);
+        bio::get(i, end);
+        if (m != b.model || begin != b.begin || end != b.end)
+            throw std::runtime_error("Checkpoint passt nicht zum Netz (Neuronen-Modelle)");
+        bio::get_vec(i, b.aux);
+    }
+
+    HormoneSystem& H = net.H;
+    bio::get(i, H.current);
+    bio::get(i, H.target);
+    bio::get(i, H.event_timer);
+    bio::get(i, H.drive_dopamine);
+    bio::get(i, H.drive_cortisol);
+    bio::get(i, H.drive_adrenaline);
+    bio::get_rng(i, H.rng);
+
+    get_store(i, net.syn);
+    get_store(i, net.syn_static);
+
+    bio::get(i, net.pending_reward);
+    bio::get(i, net.n_rewards);
+    uint64_t n_elig = 0;
+    bio::get(i, n_elig);
+    for (auto& el : net.elig) el.clear();
+    for (uint64_t e = 0; e < n_elig; ++e) {
+        EligibilityTraces::Entry x;
+        bio::get(i, x);
+        net.elig[net.partition_of(x.pre)].insert(x);   // Shard des Pre-Neurons
+    }
+
+    net.dq.load(i);
+    net.readout.load(i);
+    if (net.engine == Engine::Event) net.ev.load(i);
+}
+
+uint64_t state_hash(const Net& net) {
+    Fnv f;
+    f.pod(net.tick);
+    f.vec(net.neu.V);
+    for (const auto& b : net.neu.blocks) f.vec(b.aux);   // LIF-Blöcke sind leer
+    std::vector<uint8_t> spk(net.neu.N, 0);   // dicht wie früher, damit Hashes vergleichbar bleiben
+    for (int i : net.neu.spikes) spk[i] = 1;
+    f.vec(spk);
+    f.pod(net.neu.vth_shift);
+    f.vec(net.pre_trace);
+    f.vec(net.post_trace);
+    f.pod(net.H.current);
+    for (const SynapseStore* s : { &net.syn, &net.syn_static }) {
+        f.vec(s->rows.start);
+        f.vec(s->rows.len);
+        f.vec(s->target);
+        f.vec(s->w32);
+        f.vec(s->w16);
+        f.vec(s->w8);
+        f.vec(s->block_scale);
+    }
+    // Eligibility unabhängig von Shard-Aufteilung und Einfügereihenfolge
+    std::vector<EligibilityTraces::Entry> el;
+    for (const auto& s : net.elig) el.insert(el.end(), s.entries().begin(), s.entries().end());
+    std::sort(el.begin(), el.end(), [](const auto& a, const auto& b) { return a.k < b.k; });
+    for (const auto& x : el) {
+        f.pod(x.k);
+        f.pod(x.e);
+        f.pod(x.tick);
+    }
+    return f.h;
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include <string>
+#include <cstdint>
+
+class Net;
+
+// Checkpoint = kompletter Laufzeit-Zustand (Membran, Synapsen, Traces, Delay-Queue,
+// Hormone, Zufallsgeneratoren). Struktur-Parameter (Engine, dt, Populationen) kommen
+// aus dem Aufbau: vor load_checkpoint das Netz mit denselben Argumenten bauen.
+void save_checkpoint(const Net& net, const std::string& path);
+void load_checkpoint(Net& net, const std::string& path);
+
+// Fingerabdruck des dynamischen Zustands (Spikes, V, Gewichte, Traces, Hormone)
+uint64_t state_hash(const Net& net);
@@ -0,0 +1,387 @@
+#include "cluster.h"
+#include "net.h"
+#include <algorithm>
+#include <cmath>
+#include <csignal>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+constexpr int kMaxInterval = 16;   // begrenzt Befehls-Latenz und Readout-Verzögerung
+pid_t g_parent = 0;
+}
+
+void Cluster::launch(int procs, size_t ring_bytes) {
+    size = procs;
+    const size_t per = ShmRing::footprint(ring_bytes);
+    shm_.create("/gizmo_brain_" + std::to_string(getpid()), per * procs * procs);
+    auto ring_mem = [&](int from, int to) {
+        return static_cast<uint8_t*>(shm_.base()) + per * (static_cast<size_t>(from) * procs + to);
+    };
+
+    // 1️⃣ Ringe anlegen, solange es nur einen Prozess gibt
+    for (int a = 0; a < procs; ++a)
+        for (int b = 0; b < procs; ++b)
+            if (a != b) ShmRing().attach(ring_mem(a, b), ring_bytes, true);
+
+    // 2️⃣ Kinder forken: sie erben Netz (Copy-on-Write) und Mapping
+    g_parent = getpid();
+    for (int r = 1; r < procs; ++r) {
+        const pid_t pid = fork();
+        if (pid < 0) throw std::runtime_error("fork fehlgeschlagen");
+        if (pid == 0) {
+            rank = r;
+            children_.clear();
+            prctl(PR_SET_PDEATHSIG, SIGTERM);         // stirbt Rank 0, gehen die Kinder mit
+            if (getppid() != g_parent) _exit(1);
+            std::signal(SIGINT, SIG_IGN);             // Ctrl+C beendet über Rank 0
+            break;
+        }
+        children_.push_back(pid);
+    }
+    if (rank == 0) shm_.unlink();                     // Mapping bleibt, Name verschwindet
+
+    // 3️⃣ eigene Ringe: out_[p] = rank -> p, in_[p] = p -> rank
+    out_.resize(procs);
+    in_.resize(procs);
+    for (int p = 0; p < procs; ++p) {
+        if (p == rank) continue;
+        out_[p].attach(ring_mem(rank, p), ring_bytes, false);
+        in_[p].attach(ring_mem(p, rank), ring_bytes, false);
+    }
+    outbox_.assign(procs, {});
+    inbox_.assign(procs, {});
+    inbox_pos_.assign(procs, 0);
+}
+
+int Cluster::owner(int i) const {
+    return static_cast<int>(std::upper_bound(bounds.begin() + 1, bounds.end(), i) - bounds.begin()) - 1;
+}
+
+void Cluster::partition(Net& net, int threads) {
+    const int N = net.neu.N;
+    bounds.resize(size + 1);
+    for (int r = 0; r <= size; ++r) bounds[r] = static_cast<int>(static_cast<long>(N) * r / size);
+    lo_ = bounds[rank];
+    hi_ = bounds[rank + 1];
+
+    // 1️⃣ Synapsen einsortieren: behalten, was auf eigene Neuronen zeigt; Export-Masken;
+    //    kleinstes Delay über eine Grenze (jeder Prozess sieht hier noch das ganze Netz)
+    export_.assign(size, std::vector<uint8_t>(hi_ - lo_, 0));
+    ghost_.assign(N, 0);
+    int dmin = SynapseStore::kMaxDelay + 1;
+    std::vector<Synapse> keep[2];   // plastisch / fest, Klasse bleibt erhalten
+    const SynapseStore* stores[2] = { &net.syn, &net.syn_static };
+    for (int pre = 0; pre < N; ++pre) {
+        const int op = owner(pre);
+        for (int c = 0; c < 2; ++c) {
+            const SynapseStore& syn = *stores[c];
+            for (int k = syn.row_begin(pre); k < syn.row_end(pre); ++k) {
+                const int post = syn.post(k);
+                const int oq = (post >= lo_ && post < hi_) ? rank : owner(post);
+                if (op != oq) {
+                    if (net.hop_gain[syn.delay(k)] > 0.0f) dmin = std::min<int>(dmin, syn.delay(k));
+                    if (op == rank) export_[oq][pre - lo_] = 1;
+                }
+                if (oq != rank) continue;
+                keep[c].push_back({ pre, post, syn.weight(k), syn.delay(k), syn.plastic(k) });
+                if (op != rank) {
+                    ghost_[pre] = 1;
+                    ++n_ghost_synapses;
+                }
+            }
+        }
+    }
+    // prozedurale Projektionen: nichts zu behalten, aber Grenzen, Export und Geister wie oben
+    std::vector<std::pair<uint32_t, float>> gen;
+    for (int pre = 0; pre < N && !net.procedural.empty(); ++pre) {
+        const int op = owner(pre);
+        gen.clear();
+        net.procedural_row(pre, gen);
+        for (const auto& [t, w] : gen) {
+            const int post  = static_cast<int>(t & SynapseStore::kPostMask);
+            const int delay = static_cast<int>(t >> SynapseStore::kDelayShift);
+            const int oq = (post >= lo_ && post < hi_) ? rank : owner(post);
+            if (op != oq) {
+                if (net.hop_gain[delay] > 0.0f) dmin = std::min(dmin, delay);
+                if (op == rank) export_[oq][pre - lo_] = 1;
+            }
+            if (oq == rank && op != rank) {
+                ghost_[pre] = 1;
+                ++n_ghost_synapses;
+            }
+        }
+    }
+    if (rank != 0)
+        for (int i = lo_; i < hi_; ++i)
+            if (net.is_output[i]) export_[0][i - lo_] = 1;   // für den Readout auf Rank 0
+
+    interval = std::min(dmin + 1, kMaxInterval);
+    ghost_pres_.clear();
+    for (int pre = 0; pre < N; ++pre)
+        if (ghost_[pre]) ghost_pres_.push_back(pre);
+
+    // 2️⃣ Stores nur mit den eigenen Synapsen neu packen
+    net.syn.build(N, keep[0], net.weight_format, net.syn.scale_bound);
+    net.syn_static.build(N, keep[1], net.weight_format, net.syn_static.scale_bound);
+    net.syn.build_post_index(N);   // spike-getriebene STDP über die eingehenden Synapsen
+
+    // 3️⃣ Net rechnet ab jetzt nur [lo, hi), Worker erst nach dem fork
+    net.partitioned = true;
+    net.threads = threads;
+    net.set_owned(lo_, hi_);
+
+    local_spk_.clear();
+    local_off_.assign(1, 0);
+    mod_.clear();
+    post_trace0_.assign(net.post_trace.begin() + lo_, net.post_trace.begin() + hi_);
+    local_sp_.assign(hi_ - lo_, 0);
+    remote_sp_.assign(N, 0);
+}
+
+Cluster::Rec* Cluster::out_append(int peer, size_t n) {
+    auto& box = outbox_[peer];
+    box.resize(box.size() + n);          // Value-Init: Füllbytes von Befehlstexten sind 0
+    return &box[box.size() - n];
+}
+
+void Cluster::flush(int peer) {
+    auto& box = outbox_[peer];
+    if (box.empty()) return;
+    const size_t bytes = out_[peer].write_some(box.data(), box.size() * sizeof(Rec), sizeof(Rec));
+    box.erase(box.begin(), box.begin() + bytes / sizeof(Rec));
+}
+
+void Cluster::pull(int peer) {
+    const size_t bytes = in_[peer].readable() / sizeof(Rec) * sizeof(Rec);
+    if (bytes == 0) return;
+    auto& box = inbox_[peer];
+    const size_t old = box.size();
+    box.resize(old + bytes / sizeof(Rec));
+    in_[peer].read_some(&box[old], bytes, sizeof(Rec));
+}
+
+void Cluster::check_peers() {
+    if (rank != 0) {
+        if (getppid() != g_parent) _exit(1);
+        return;
+    }
+    for (size_t c = 0; c < children_.size(); ++c)
+        if (waitpid(children_[c], nullptr, WNOHANG) != 0)
+            throw std::runtime_error("Partition " + std::to_string(c + 1) + " hat sich unerwartet beendet");
+}
+
+void Cluster::wait_a_bit(unsigned& spins) {
+    if (++spins % 4096 == 0) check_peers();
+    if (spins > 64) std::this_thread::yield();
+}
+
+void Cluster::flush_all_blocking() {
+    unsigned spins = 0;
+    for (;;) {
+        bool pending = false;
+        for (int p = 0; p < size; ++p) {
+            if (p == rank) continue;
+            flush(p);
+            pending |= !outbox_[p].empty();
+        }
+        if (!pending) return;
+        // Ring voll: eingehende Ringe leeren, sonst warten zwei Prozesse aufeinander
+        for (int p = 0; p < size; ++p)
+            if (p != rank) pull(p);
+        wait_a_bit(spins);
+    }
+}
+
+void Cluster::receive_until_end(int peer) {
+    auto& box = inbox_[peer];
+    size_t& pos = inbox_pos_[peer];
+    unsigned spins = 0;
+    for (;;) {
+        while (pos < box.size()) {
+            const Rec& r = box[pos];
+            const long j = r.tick - interval_begin;
+            if (r.kind == kSpike) {
+                remote_[j].push_back(r.val);
+            } else if (r.kind == kCount) {
+                tick_spikes[j] += r.val;
+            } else if (r.kind == kCmd) {
+                const size_t n = (static_cast<size_t>(r.val) + sizeof(Rec) - 1) / sizeof(Rec);
+                if (pos + 1 + n > box.size()) break;      // Text noch nicht ganz da
+                const char* text = reinterpret_cast<const char*>(&box[pos + 1]);
+                commands.push_back(nlohmann::json::parse(text, text + r.val));
+                pos += n;
+            } else if (r.kind == kEnd) {
+                if (peer == 0) stop = r.val != 0;
+                ++pos;
+                box.erase(box.begin(), box.begin() + pos);
+                pos = 0;
+                return;
+            }
+            ++pos;
+        }
+        pull(peer);
+        wait_a_bit(spins);
+    }
+}
+
+void Cluster::after_tick(const Net& net) {
+    const long s = net.tick - 1;
+    const size_t first = local_spk_.size();
+    local_spk_.insert(local_spk_.end(), net.neu.spikes.begin(), net.neu.spikes.end());
+    local_off_.push_back(local_spk_.size());
+    mod_.push_back(net.stdp_mod());
+
+    // gleich losschicken: der Empfänger braucht die IDs erst an der Intervallgrenze
+    for (int p = 0; p < size; ++p) {
+        if (p == rank) continue;
+        const auto& ex = export_[p];
+        for (size_t x = first; x < local_spk_.size(); ++x) {
+            const int i = local_spk_[x];
+            if (!ex[i - lo_]) continue;
+            *out_append(p, 1) = { s, kSpike, i };
+            ++n_sent;
+        }
+        if (p == 0) *out_append(0, 1) = { s, kCount, static_cast<int32_t>(local_spk_.size() - first) };
+        flush(p);
+    }
+}
+
+void Cluster::exchange(Net& net, const std::vector<nlohmann::json>& cmds, bool stop_all) {
+    const int K = static_cast<int>(local_off_.size()) - 1;
+    interval_begin = net.tick - K;
+    commands.clear();
+    tick_spikes.assign(K, 0);
+    remote_.resize(K);
+    for (auto& r : remote_) r.clear();
+
+    // 1️⃣ Rank 0: Befehle (als JSON-Text) und Stopp an alle; dann Intervall-Ende
+    if (rank == 0) {
+        for (const auto& c : cmds) {
+            const std::string text = c.dump();
+            const size_t n = (text.size() + sizeof(Rec) - 1) / sizeof(Rec);
+            for (int p = 1; p < size; ++p) {
+                Rec* r = out_append(p, 1 + n);
+                r[0] = { net.tick, kCmd, static_cast<int32_t>(text.size()) };
+                std::memcpy(r + 1, text.data(), text.size());
+            }
+        }
+        commands = cmds;
+        stop = stop_all;
+    }
+    for (int p = 0; p < size; ++p)
+        if (p != rank) *out_append(p, 1) = { net.tick, kEnd, (rank == 0 && stop_all) ? 1 : 0 };
+    flush_all_blocking();
+
+    // 2️⃣ von allen Peers bis zu ihrem Intervall-Ende lesen (feste Reihenfolge -> deterministisch)
+    for (int p = 0; p < size; ++p)
+        if (p != rank) receive_until_end(p);
+    for (int j = 0; j < K; ++j)
+        tick_spikes[j] += static_cast<long>(local_off_[j + 1] - local_off_[j]);
+
+    // 3️⃣ STDP + Weiterleitung der fremden Spikes nachholen, Readout auf Rank 0
+    replay_ghost_rows(net);
+    if (rank == 0) lagged_readout(net);
+
+    // 4️⃣ neues Intervall
+    local_spk_.clear();
+    local_off_.assign(1, 0);
+    mod_.clear();
+    post_trace0_.assign(net.post_trace.begin() + lo_, net.post_trace.begin() + hi_);
+}
+
+void Cluster::replay_ghost_rows(Net& net) {
+    if (ghost_pres_.empty()) return;
+    auto& syn = net.syn;
+    const float dp = std::exp(-net.neu.dt / net.tau_pre);
+    const float dq = std::exp(-net.neu.dt / net.tau_post);
+    auto& tr = post_trace0_;     // läuft hier Tick für Tick mit, wie post_trace im Original
+
+    for (size_t j = 0; j < remote_.size(); ++j) {
+        const long s = interval_begin + static_cast<long>(j);
+
+        // 1️⃣ Traces auf Tick s bringen (gleiche Reihenfolge wie stdp_decay/apply_updates)
+        for (auto& x : tr) x *= dq;
+        for (size_t x = local_off_[j]; x < local_off_[j + 1]; ++x) {
+            tr[local_spk_[x] - lo_] += 1.0f;
+            local_sp_[local_spk_[x] - lo_] = 1;
+        }
+        for (int pre : ghost_pres_) net.pre_trace[pre] *= dp;
+        for (int pre : remote_[j]) {
+            if (!ghost_[pre]) continue;
+            net.pre_trace[pre] += 1.0f;
+            remote_sp_[pre] = 1;
+        }
+
+        // 2️⃣ STDP der Geister-Zeilen (nur plastischer Store)
+        const float mod = mod_[j];
+        for (int pre : ghost_pres_) {
+            const bool pre_sp = remote_sp_[pre] != 0;
+            for (int k = syn.row_begin(pre); k < syn.row_end(pre); ++k) {
+                const float w = syn.weight(k);
+                const int  post    = syn.post(k);
+                const bool post_sp = local_sp_[post - lo_] != 0;
+                if (!pre_sp && !post_sp) continue;
+
+                float dw = 0.0f;
+                if (post_sp) dw += net.learning_rate * net.Aplus  * net.pre_trace[pre] * mod;
+                if (pre_sp)  dw -= net.learning_rate * net.Aminus * tr[post - lo_]    * mod;
+                syn.set_weight(k, std::clamp(w + dw, net.wmin, net.wmax));
+            }
+        }
+
+        // 3️⃣ mit den eben gelernten Gewichten weiterleiten (Ankunft liegt nach dem Austausch)
+        for (int pre : remote_[j]) {
+            if (!ghost_[pre] || net.is_output[pre]) continue;
+            net.route_row(pre, net.tick - 1, s);
+        }
+
+        for (size_t x = local_off_[j]; x < local_off_[j + 1]; ++x) local_sp_[local_spk_[x] - lo_] = 0;
+        for (int pre : remote_[j]) remote_sp_[pre] = 0;
+    }
+}
+
+void Cluster::lagged_readout(Net& net) {
+    std::vector<int> outs;
+    for (size_t j = 0; j < remote_.size(); ++j) {
+        const long s = interval_begin + static_cast<long>(j);
+        outs.clear();
+        for (size_t x = local_off_[j]; x < local_off_[j + 1]; ++x)
+            if (net.is_output[local_spk_[x]]) outs.push_back(local_spk_[x]);
+        for (int pre : remote_[j])
+            if (net.is_output[pre]) outs.push_back(pre);
+        std::sort(outs.begin(), outs.end());
+
+        net.readout.advance(s);
+        for (int o : outs) net.readout.on_spike(o, s);
+        net.readout.decode(s);
+    }
+}
+
+uint64_t Cluster::gather_hash(uint64_t own) {
+    if (rank != 0) {
+        *out_append(0, 1) = { static_cast<int64_t>(own), kHash, 0 };
+        flush_all_blocking();
+        return own;
+    }
+
+    // FNV über die Hashes in Rank-Reihenfolge
+    uint64_t h = 1469598103934665603ull;
+    auto mix = [&](uint64_t x) { h ^= x; h *= 1099511628211ull; };
+    mix(own);
+    for (int p = 1; p < size; ++p) {
+        auto& box = inbox_[p];
+        while (inbox_pos_[p] >= box.size()) {
+            pull(p);
+            std::this_thread::yield();
+        }
+        mix(static_cast<uint64_t>(box[inbox_pos_[p]++].tick));
+    }
+    for (pid_t c : children_) waitpid(c, nullptr, 0);
+    children_.clear();
+    return h;
+}
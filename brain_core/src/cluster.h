@@ -0,0 +1,89 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <sys/types.h>
+#include <nlohmann/json.hpp>
+#include "shm_ring.h"
+
+class Net;
+
+// Ein Netz auf mehrere brain-Prozesse verteilt (--procs N, gleicher Host).
+//
+//  - Prozess r besitzt die Neuronen [bounds[r], bounds[r+1]) und alle Synapsen, die
+//    auf sie zeigen (auch die von fremden Pre-Neuronen, "Geister-Zeilen").
+//    Jeder Prozess baut das Netz identisch, verwirft dann alle fremden Synapsen.
+//  - Über die Grenze gehen nur Spike-IDs, und nur an Prozesse, die eine Synapse
+//    des Neurons halten (plus Output-Spikes an Rank 0 für den Readout).
+//  - Ausgetauscht wird alle `interval` Ticks = kleinstes Delay über eine Grenze + 1:
+//    ein fremder Spike aus Tick s kommt frühestens in s + 1 + delay an, also erst
+//    nach dem Austausch. Die Spikes laufen schon während des Intervalls in die
+//    Ringe (kein Warten), blockiert wird nur an der Intervallgrenze.
+//  - STDP der Geister-Zeilen wird beim Austausch Tick für Tick nachgeholt
+//    (Pre-Trace aus den empfangenen Spikes, Post-Trace aus der lokalen Historie).
+//  - Rank 0 liest die Befehle und verteilt sie, rechnet den Readout (eine
+//    Intervalllänge verzögert) und schreibt als einziger Logs.
+//
+// Transport: ein SPSC-Ring pro Richtung in einem POSIX-Shared-Memory-Segment.
+class Cluster {
+public:
+    int rank = 0;
+    int size = 1;
+    std::vector<int> bounds;          // size + 1 Einträge
+    int  interval = 1;                // Ticks pro Austausch
+    long n_sent = 0;                  // Spike-IDs über Partitionsgrenzen
+    long n_ghost_synapses = 0;        // Synapsen von fremden Pre-Neuronen
+
+    // Ergebnis des letzten Austauschs
+    std::vector<nlohmann::json> commands;   // von Rank 0, für alle ab dem nächsten Tick
+    std::vector<long> tick_spikes;          // Rank 0: Spikes pro Tick des Intervalls (alle Prozesse)
+    long interval_begin = 0;                // erster Tick des letzten Intervalls
+    bool stop = false;
+
+    // forkt size - 1 Kind-Prozesse, kehrt in jedem Prozess mit eigenem rank zurück
+    void launch(int procs, size_t ring_bytes = size_t(4) << 20);
+    // Grenzen festlegen, fremde Synapsen verwerfen, Austausch-Intervall bestimmen
+    void partition(Net& net, int threads);
+
+    bool due(long tick) const { return tick % interval == 0; }
+    void after_tick(const Net& net);        // nach step_once: eigene Spikes verschicken
+    // an der Intervallgrenze: Rank 0 gibt Befehle und Stopp-Wunsch mit
+    void exchange(Net& net, const std::vector<nlohmann::json>& cmds, bool stop_all);
+
+    // Ende: Rank 0 kombiniert die State-Hashes aller Prozesse, wartet auf die Kinder
+    uint64_t gather_hash(uint64_t own);
+
+private:
+    struct Rec { int64_t tick; int32_t kind; int32_t val; };
+    enum Kind : int32_t { kSpike = 1, kCount, kCmd, kEnd, kHash };
+
+    int  owner(int i) const;
+    Rec* out_append(int peer, size_t n);
+    void flush(int peer);
+    void flush_all_blocking();
+    void pull(int peer);
+    void receive_until_end(int peer);
+    void check_peers();
+    void wait_a_bit(unsigned& spins);
+    void replay_ghost_rows(Net& net);
+    void lagged_readout(Net& net);
+
+    ShmSegment shm_;
+    std::vector<ShmRing> out_, in_;              // pro Peer
+    std::vector<std::vector<Rec>> outbox_, inbox_;
+    std::vector<size_t> inbox_pos_;
+    std::vector<pid_t> children_;
+
+    int lo_ = 0, hi_ = 0;                          // eigene Neuronen
+    std::vector<std::vector<uint8_t>> export_;     // pro Peer: Neuron i geht an ihn
+    std::vector<uint8_t> ghost_;                   // pro Neuron: fremd, hat hier Synapsen
+    std::vector<int> ghost_pres_;                  // dieselben als Liste
+
+    // Historie des laufenden Intervalls
+    std::vector<int>   local_spk_;                 // eigene Spikes, flach
+    std::vector<size_t> local_off_;                // pro Tick: Beginn in local_spk_
+    std::vector<float> mod_;                       // STDP-Modulation pro Tick
+    std::vector<float> post_trace0_;               // post_trace [lo, hi) am Intervallbeginn
+    std::vector<std::vector<int>> remote_;         // pro Tick: empfangene Spikes (Peers in Rank-Reihenfolge)
+    std::vector<uint8_t> local_sp_, remote_sp_;    // Spike-Marken beim Nachholen
+};
@@ -0,0 +1,148 @@
+#include "commands.h"
+#include "net.h"
+#include "io_logger.h"
+#include "memory_report.h"
+#include <stdexcept>
+#include <algorithm>
+
+// gültige Indizes in input_target aus einem JSON-Array (Rest wird ignoriert)
+static std::vector<int> input_indices(const Net& net, const nlohmann::json& arr) {
+    const int n_in = static_cast<int>(net.input_target.size());
+    std::vector<int> out;
+    for (int i : arr.get<std::vector<int>>())
+        if (i >= 0 && i < n_in) out.push_back(i);
+    return out;
+}
+
+bool apply_command(Net& net, const std::string& cmd, const nlohmann::json& data) {
+    if (cmd == "set_hormones") {
+        if (data.contains("dopamine"))
+            net.H.set_dopamine_drive(data["dopamine"]);
+        if (data.contains("cortisol"))
+            net.H.set_cortisol_drive(data["cortisol"]);
+        if (data.contains("adrenaline"))
+            net.H.set_adrenaline_drive(data["adrenaline"]);
+
+        IoLogger::instance().log_status("🧠 Hormone drives updated via command");
+    }
+    else if (cmd == "reward") {
+        // data: value (>0 belohnt, <0 bestraft); wirkt im nächsten Tick auf die Eligibility-Traces
+        const float r = data.value("value", 0.0f);
+        if (net.plasticity != Plasticity::Reward) {
+            IoLogger::instance().log_status("🎯 Reward ignoriert (--plasticity stdp)");
+        } else {
+            net.pending_reward += r;
+            IoLogger::instance().log_status("🎯 Reward " + std::to_string(r) + " auf "
+                                            + std::to_string(net.n_eligible()) + " Eligibility-Traces");
+        }
+    }
+    else if (cmd == "input_pattern" || cmd == "input") {
+        // dichtes 0/1-Muster über die Input-Schicht, ein Tick
+        auto pattern = data.value("pattern", std::vector<int>{});
+        Stimulus s;
+        s.start = net.tick;
+        const size_t n = std::min(pattern.size(), net.input_target.size());
+        for (size_t i = 0; i < n; ++i)
+            if (pattern[i]) s.inputs.push_back(static_cast<int>(i));
+        if (!s.inputs.empty()) {
+            net.stimuli.add(std::move(s));
+            IoLogger::instance().log_status("🧠 External input pattern applied");
+        }
+    }
+    else if (cmd == "stimulus") {
+        // data: entries = [{inputs, amp, start (Ticks ab jetzt), duration, repeat, period}, ...]
+        //       oder ein einzelner Eintrag direkt in data; clear = true verwirft alle geplanten Reize
+        if (data.value("clear", false)) net.stimuli.clear();
+        size_t added = 0, weak = 0;
+        auto add_entry = [&](const nlohmann::json& e) {
+            Stimulus s;
+            s.inputs   = input_indices(net, e.value("inputs", nlohmann::json::array()));
+            s.amp      = e.value("amp", 1.0f);
+            s.start    = net.tick + std::max(0L, e.value("start", 0L));
+            s.duration = e.value("duration", 1);
+            s.repeat   = e.value("repeat", 0);
+            s.period   = e.value("period", 0);
+            if (s.inputs.empty()) return;
+            if (!net.input_fires(s.amp, s.duration)) ++weak;
+            net.stimuli.add(std::move(s));
+            ++added;
+        };
+        if (data.contains("entries")) {
+            for (const auto& e : data["entries"]) add_entry(e);
+        } else if (data.contains("inputs")) {
+            add_entry(data);
+        }
+        IoLogger::instance().log_status("🧠 Stimulus: " + std::to_string(added) + " Einträge geplant, "
+                                        + std::to_string(net.stimuli.pending()) + " wartend"
+                                        + (weak ? ", ⚠️ " + std::to_string(weak) + " zu schwach für einen Input-Spike"
+                                                : std::string()));
+    }
+    else if (cmd == "input_sequence") {
+        // data: steps = [[Input-Index, ...], ...], ticks_per_token, amplitude; ein Reiz pro Schritt
+        if (data.value("clear", false)) net.stimuli.clear();
+        const int   ticks = std::max(1, data.value("ticks_per_token", 20));
+        const float amp   = data.value("amplitude", 1.0f);
+        long start = net.tick;
+        size_t n_steps = 0;
+        for (const auto& st : data.value("steps", nlohmann::json::array())) {
+            Stimulus s;
+            s.inputs   = input_indices(net, st);
+            s.amp      = amp;
+            s.start    = start;
+            s.duration = ticks;
+            net.stimuli.add(std::move(s));   // leerer Schritt = Pause
+            start += ticks;
+            ++n_steps;
+        }
+        IoLogger::instance().log_status("🧠 Input sequence started: " + std::to_string(n_steps)
+                                        + " Schritte à " + std::to_string(ticks) + " Ticks"
+                                        + (n_steps && !net.input_fires(amp, ticks)
+                                               ? ", ⚠️ amplitude zu schwach für einen Input-Spike" : ""));
+    }
+    else if (cmd == "memory_report") {
+        // {"cmd":"memory_report"} -> Speicherbilanz nach log.jsonl (type "memory")
+        IoLogger::instance().log_memory(memory_report(net).to_json());
+    }
+    else if (cmd == "exit") {
+        IoLogger::instance().log_status("🛑 Exit command received");
+        return false;
+    }
+    return true;
+}
+
+void CommandLog::open(const std::string& path) {
+    out_.open(path, std::ios::out | std::ios::trunc);
+}
+
+void CommandLog::record(long tick, const std::string& cmd, const nlohmann::json& data) {
+    if (!out_.is_open()) return;
+    nlohmann::json j = { {"tick", tick}, {"cmd", cmd}, {"data", data} };
+    out_ << j.dump() << "\n";
+    out_.flush();
+}
+
+void CommandLog::close(long end_tick) {
+    if (!out_.is_open()) return;
+    out_ << nlohmann::json{ {"tick", end_tick}, {"cmd", "end"} }.dump() << "\n";
+    out_.close();
+}
+
+std::vector<LoggedCommand> load_command_log(const std::string& path, long& end_tick) {
+    std::ifstream f(path);
+    if (!f.is_open()) throw std::runtime_error("Befehls-Log nicht gefunden: " + path);
+
+    std::vector<LoggedCommand> out;
+    end_tick = -1;
+    std::string line;
+    while (std::getline(f, line)) {
+        if (line.empty()) continue;
+        auto j = nlohmann::json::parse(line);
+        LoggedCommand c;
+        c.tick = j.at("tick").get<long>();
+        c.cmd  = j.value("cmd", "");
+        if (c.cmd == "end") { end_tick = c.tick; break; }
+        c.data = j.value("data", nlohmann::json::object());
+        out.push_back(std::move(c));
+    }
+    return out;
+}
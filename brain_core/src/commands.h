@@ -0,0 +1,33 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+class Net;
+
+// Wendet einen Befehl aus commands.jsonl an (Live und Replay teilen sich diesen Weg).
+// Gibt false zurück, wenn der Befehl das Brain beenden soll ("exit").
+bool apply_command(Net& net, const std::string& cmd, const nlohmann::json& data);
+
+// Befehl mit dem Tick, in dem er wirksam wurde (vor step_once dieses Ticks)
+struct LoggedCommand {
+    long tick = 0;
+    std::string cmd;
+    nlohmann::json data;
+};
+
+// Protokoll der angewendeten Befehle: eine JSON-Zeile pro Befehl,
+// am Ende ein {"cmd":"end"} mit dem letzten Tick des Laufs.
+class CommandLog {
+public:
+    void open(const std::string& path);
+    void record(long tick, const std::string& cmd, const nlohmann::json& data);
+    void close(long end_tick);
+
+private:
+    std::ofstream out_;
+};
+
+// lädt ein Protokoll; end_tick = Tick des "end"-Eintrags (-1, wenn der Lauf abgebrochen ist)
+std::vector<LoggedCommand> load_command_log(const std::string& path, long& end_tick);
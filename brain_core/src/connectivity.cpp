@@ -0,0 +1,60 @@
+#include "connectivity.h"
+#include <unordered_set>
+#include <algorithm>
+#include <cmath>
+
+float Distribution::sample(CounterRng& r) const {
+    switch (kind) {
+        case Uniform: return a + (b - a) * r.uniform();
+        case Normal:  return a + b * r.normal();
+        default:      return a;
+    }
+}
+
+float Distribution::abs_bound() const {
+    switch (kind) {
+        case Uniform: return std::max(std::fabs(a), std::fabs(b));
+        case Normal:  return std::fabs(a) + 4.0f * b;
+        default:      return std::fabs(a);
+    }
+}
+
+void sample_distinct(CounterRng& r, int m, int n, int exclude, std::vector<int>& out) {
+    out.clear();
+    const int avail = m - (exclude >= 0 ? 1 : 0);
+    n = std::min(n, avail);
+    if (n <= 0) return;
+
+    std::unordered_set<int> seen;
+    const bool use_set = n > 32;
+    auto contains = [&](int v) {
+        return use_set ? seen.count(v) != 0 : std::find(out.begin(), out.end(), v) != out.end();
+    };
+    for (int j = avail - n; j < avail; ++j) {
+        int t = static_cast<int>(r.below(static_cast<uint32_t>(j + 1)));
+        if (contains(t)) t = j;
+        out.push_back(t);
+        if (use_set) seen.insert(t);
+    }
+    if (exclude >= 0)
+        for (int& v : out) if (v >= exclude) ++v;
+    std::sort(out.begin(), out.end());
+}
+
+void sources_of(uint64_t seed, int proj, const ProjectionSpec& pr, const ProjRange& g, int j,
+                std::vector<int>& out) {
+    CounterRng r(seed, proj, static_cast<uint64_t>(g.d0 + j), kTargets);
+    sample_distinct(r, g.ns, pr.n, g.no_self ? j : -1, out);
+}
+
+int sample_delay_ticks(const Distribution& d, CounterRng& r, float dt_ms) {
+    int ticks;
+    if (d.kind == Distribution::Uniform) {
+        const int lo = static_cast<int>(std::lround(d.a / dt_ms));
+        const int hi = static_cast<int>(std::lround(d.b / dt_ms));
+        ticks = lo + static_cast<int>(r.below(static_cast<uint32_t>(std::max(0, hi - lo) + 1)));
+    } else {
+        ticks = static_cast<int>(std::lround(d.sample(r) / dt_ms));
+    }
+    return std::clamp(ticks, 0, SynapseStore::kMaxDelay);
+}
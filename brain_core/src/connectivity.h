@@ -0,0 +1,108 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include "counter_rng.h"
+#include "synapse_store.h"
+
+// Kanten-Generatoren (deterministisch über CounterRng). Der Aufbau (network_builder.cpp)
+// und prozedurale Projektionen (Net::procedural_row) ziehen dieselben Zahlen aus
+// denselben Strömen -> gespeicherte und prozedurale Form sind dieselben Synapsen.
+
+enum class ConnRule {
+    FixedIn,    // jedes Post-Neuron bekommt n verschiedene Pre-Neuronen
+    FixedOut,   // jedes Pre-Neuron bekommt n verschiedene Post-Neuronen
+    FixedProb,  // jede Kante mit Wahrscheinlichkeit p
+    AllToAll,
+    OneToOne
+};
+
+struct Distribution {
+    enum Kind { Const, Uniform, Normal } kind = Const;
+    float a = 0.0f;  // Const: Wert | Uniform: min | Normal: mean
+    float b = 0.0f;  //                Uniform: max | Normal: std
+
+    float sample(CounterRng& r) const;
+    float abs_bound() const;
+};
+
+struct ProjectionSpec {
+    int src = 0, dst = 0;          // Index in NetSpec::populations
+    ConnRule rule = ConnRule::FixedProb;
+    int   n = 0;                   // FixedIn / FixedOut
+    float p = 0.0f;                // FixedProb
+    Distribution weight;           // Betrag, Vorzeichen kommt von der Rolle der Quelle
+    Distribution delay_ms;
+    bool plastic = true;
+    bool allow_self = false;       // nur relevant, wenn src == dst
+    bool procedural = false;       // nicht speichern, bei jedem Spike neu erzeugen (nur feste, pre-zentrierte)
+};
+
+enum ConnStream : uint64_t { kTargets = 1, kValues = 2 };
+
+struct ProjRange {
+    int s0, ns;   // Quell-Population
+    int d0, nd;   // Ziel-Population
+    bool no_self; // gleiche Population und keine Selbstverbindungen
+};
+
+// n verschiedene Werte aus [0, m) ohne `exclude` (Floyd), aufsteigend
+void sample_distinct(CounterRng& r, int m, int n, int exclude, std::vector<int>& out);
+
+// Ziele (lokal in dst, aufsteigend) eines Pre-Neurons i für pre-zentrierte Regeln
+template <class F>
+void for_each_target(uint64_t seed, int proj, const ProjectionSpec& pr, const ProjRange& g, int i,
+                     std::vector<int>& scratch, F&& fn) {
+    CounterRng r(seed, proj, static_cast<uint64_t>(g.s0 + i), kTargets);
+    const int self = g.no_self ? i : -1;
+
+    switch (pr.rule) {
+        case ConnRule::FixedOut:
+            sample_distinct(r, g.nd, pr.n, self, scratch);
+            for (int j : scratch) fn(j);
+            break;
+        case ConnRule::FixedProb: {
+            if (pr.p <= 0.0f) break;
+            if (pr.p >= 1.0f) {
+                for (int j = 0; j < g.nd; ++j) if (j != self) fn(j);
+                break;
+            }
+            // geometrische Sprünge statt nd Münzwürfe
+            const double logq = std::log1p(-static_cast<double>(pr.p));
+            long j = -1;
+            while (true) {
+                const double u = 1.0 - r.uniform();   // (0, 1]
+                j += 1 + static_cast<long>(std::min(std::floor(std::log(u) / logq), 1e9));
+                if (j >= g.nd) break;
+                if (j != self) fn(static_cast<int>(j));
+            }
+            break;
+        }
+        case ConnRule::AllToAll:
+            for (int j = 0; j < g.nd; ++j) if (j != self) fn(j);
+            break;
+        case ConnRule::OneToOne:
+            if (i != self) fn(i);
+            break;
+        case ConnRule::FixedIn:
+            break;  // post-zentriert, siehe sources_of
+    }
+}
+
+// Quellen (lokal in src) eines Post-Neurons j für FixedIn
+void sources_of(uint64_t seed, int proj, const ProjectionSpec& pr, const ProjRange& g, int j,
+                std::vector<int>& out);
+
+int sample_delay_ticks(const Distribution& d, CounterRng& r, float dt_ms);
+
+// Reihenfolge innerhalb einer Zeile: post, delay, Gewicht. Das plastic-Bit zählt nicht,
+// damit gespeicherte und prozedurale feste Zeilen gleich sortiert (= gleich summiert) werden
+inline bool row_less(const std::pair<uint32_t, float>& x, const std::pair<uint32_t, float>& y) {
+    const uint32_t px = x.first & SynapseStore::kPostMask, py = y.first & SynapseStore::kPostMask;
+    if (px != py) return px < py;
+    const uint32_t dx = x.first >> SynapseStore::kDelayShift, dy = y.first >> SynapseStore::kDelayShift;
+    if (dx != dy) return dx < dy;
+    return x.second < y.second;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+// Zustandsloser Zufall: Wert = hash(key, counter).
+// Jede (Projektion, Neuron)-Kombination hat ihren eigenen Strom, deshalb kann
+// der Aufbau in beliebiger Reihenfolge / parallel laufen und bleibt deterministisch.
+inline uint64_t mix64(uint64_t z) {
+    z += 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+struct CounterRng {
+    uint64_t key;
+    uint64_t ctr = 0;
+
+    CounterRng(uint64_t seed, uint64_t a, uint64_t b, uint64_t stream)
+        : key(mix64(mix64(mix64(seed ^ a) ^ b) ^ stream)) {}
+
+    uint64_t next() { return mix64(key + (ctr++) * 0xD1B54A32D192ED03ull); }
+
+    // [0, 1)
+    float uniform() { return static_cast<float>(next() >> 40) * (1.0f / 16777216.0f); }
+
+    // [0, n)
+    uint32_t below(uint32_t n) { return static_cast<uint32_t>(((next() >> 32) * n) >> 32); }
+
+    float normal() {
+        const float u1 = std::max(uniform(), 1e-7f);
+        const float u2 = uniform();
+        return std::sqrt(-2.0f * std::log(u1)) * std::cos(6.2831853f * u2);
+    }
+};
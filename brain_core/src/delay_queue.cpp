@@ -0,0 +1,63 @@
+#include "delay_queue.h"
+#include "binary_io.h"
+
+void DelayQueue::init(int max_delay) {
+    // Seiten im Ring: max. Abstand in Seiten + Reserve, auf 2er-Potenz gerundet
+    long pages = 1;
+    while (pages < (static_cast<long>(max_delay) >> kNearBits) + 2) pages <<= 1;
+    far_.assign(pages, {});
+    page_mask_ = pages - 1;
+    clear();
+}
+
+void DelayQueue::clear() {
+    for (auto& b : near_) b.clear();
+    for (auto& p : far_)  p.clear();
+    near_count_ = 0;
+    far_count_  = 0;
+}
+
+MemUse DelayQueue::memory() const {
+    MemUse m = mem_of(near_);
+    m += mem_of(far_);
+    for (const auto& b : near_) m += mem_of(b);
+    for (const auto& p : far_)  m += mem_of(p);
+    return m;
+}
+
+void DelayQueue::push_far(long arrival, int post, float val) {
+    far_[(arrival >> kNearBits) & page_mask_].push_back({ arrival, post, val });
+    ++far_count_;
+}
+
+// Am Anfang einer Seite: alle Ereignisse der Seite in die nahe Stufe
+void DelayQueue::promote_page(long tick) {
+    auto& page = far_[(tick >> kNearBits) & page_mask_];
+    for (const auto& e : page)
+        near_[e.arrival & (kNear - 1)].push_back({ e.post, e.val });
+    near_count_ += page.size();
+    far_count_  -= page.size();
+    page.clear();
+}
+
+void DelayQueue::save(std::ostream& o) const {
+    for (const auto& b : near_) bio::put_vec(o, b);
+    bio::put<uint64_t>(o, far_.size());
+    for (const auto& p : far_) bio::put_vec(o, p);
+    bio::put<uint64_t>(o, near_count_);
+    bio::put<uint64_t>(o, far_count_);
+}
+
+void DelayQueue::load(std::istream& i) {
+    for (auto& b : near_) bio::get_vec(i, b);
+    uint64_t pages = 0;
+    bio::get(i, pages);
+    far_.assign(pages, {});
+    for (auto& p : far_) bio::get_vec(i, p);
+    page_mask_ = static_cast<long>(pages) - 1;
+    uint64_t n = 0, f = 0;
+    bio::get(i, n);
+    bio::get(i, f);
+    near_count_ = n;
+    far_count_  = f;
+}
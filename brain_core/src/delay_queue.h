@@ -0,0 +1,65 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <iosfwd>
+#include "placement.h"
+
+// Verzögerte Spike-Zustellung. Speicher wächst mit den Ereignissen im Flug,
+// nicht mit N × max_delay wie der alte dichte Ringpuffer.
+//
+// Zweistufiges Zeitrad:
+//  - nahe Stufe: ein Bucket pro Tick für die nächsten kNear Ticks. Schneller Pfad
+//    für die häufigen kurzen Delays: push_back in einen Vektor, der seine Kapazität behält.
+//  - ferne Stufe: ein Bucket pro kNear Ticks ("Seite"). Beim Erreichen einer Seite
+//    werden ihre Ereignisse einmal in die nahe Stufe umsortiert.
+//
+// drain() muss für jeden Tick genau einmal und in Reihenfolge aufgerufen werden.
+class DelayQueue {
+public:
+    static constexpr int  kNearBits = 4;
+    static constexpr long kNear     = 1L << kNearBits;   // 16 Ticks
+
+    struct Event { int post; float val; };
+
+    void init(int max_delay);
+    void clear();
+
+    // Ankunft im Tick `arrival` (> now, now = zuletzt geleerter Tick)
+    void push(long now, long arrival, int post, float val) {
+        if (arrival - now <= kNear) {
+            near_[arrival & (kNear - 1)].push_back({ post, val });
+            ++near_count_;
+        } else {
+            push_far(arrival, post, val);
+        }
+    }
+
+    // ruft fn(post, val) für alle Ereignisse mit Ankunft == tick auf
+    template <class F>
+    void drain(long tick, F&& fn) {
+        if ((tick & (kNear - 1)) == 0) promote_page(tick);
+        auto& bucket = near_[tick & (kNear - 1)];
+        for (const auto& e : bucket) fn(e.post, e.val);
+        near_count_ -= bucket.size();
+        bucket.clear();
+    }
+
+    size_t in_flight() const { return near_count_ + far_count_; }
+    MemUse memory() const;   // belegt = Ereignisse im Flug, reserviert = Kapazität der Buckets
+
+    // Checkpoint: Buckets 1:1 (Reihenfolge bestimmt die Summationsreihenfolge in Isyn)
+    void save(std::ostream& o) const;
+    void load(std::istream& i);
+
+private:
+    struct FarEvent { long arrival; int post; float val; };
+
+    void push_far(long arrival, int post, float val);
+    void promote_page(long tick);
+
+    std::vector<std::vector<Event>>    near_ = std::vector<std::vector<Event>>(kNear);
+    std::vector<std::vector<FarEvent>> far_;
+    long   page_mask_  = 0;
+    size_t near_count_ = 0;
+    size_t far_count_  = 0;
+};
@@ -0,0 +1,54 @@
+#include "eligibility.h"
+#include "synapse_store.h"
+
+void EligibilityTraces::add(uint32_t k, int pre, int post, float de, long tick, float decay) {
+    const auto it = slot_.find(k);
+    if (it == slot_.end()) {
+        slot_.emplace(k, static_cast<uint32_t>(entries_.size()));
+        entries_.push_back({ k, pre, post, de, tick });
+        return;
+    }
+    Entry& x = entries_[it->second];
+    decay_to(x, tick, decay);
+    x.e += de;
+}
+
+void EligibilityTraces::erase_at(size_t i) {
+    slot_.erase(entries_[i].k);
+    if (i + 1 != entries_.size()) {
+        entries_[i] = entries_.back();
+        slot_[entries_[i].k] = static_cast<uint32_t>(i);
+    }
+    entries_.pop_back();
+}
+
+void EligibilityTraces::remap(const SynapseStore& s) {
+    std::vector<Entry> old;
+    old.swap(entries_);
+    slot_.clear();
+    for (Entry x : old) {
+        const int k = s.find(x.pre, x.post);
+        if (k < 0 || slot_.count(static_cast<uint32_t>(k))) continue;   // abgebaut / Duplikat
+        x.k = static_cast<uint32_t>(k);
+        insert(x);
+    }
+}
+
+void EligibilityTraces::insert(const Entry& x) {
+    slot_[x.k] = static_cast<uint32_t>(entries_.size());
+    entries_.push_back(x);
+}
+
+MemUse EligibilityTraces::memory() const {
+    MemUse m = mem_of(entries_);
+    // unordered_map: ein Knoten pro Eintrag (Wert + next-Zeiger), dazu das Bucket-Array
+    const size_t node = sizeof(std::pair<const uint32_t, uint32_t>) + sizeof(void*);
+    m.bytes    += slot_.size() * node + slot_.bucket_count() * sizeof(void*);
+    m.reserved += slot_.size() * node + slot_.bucket_count() * sizeof(void*);
+    return m;
+}
+
+void EligibilityTraces::clear() {
+    slot_.clear();
+    entries_.clear();
+}
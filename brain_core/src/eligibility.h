@@ -0,0 +1,62 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cmath>
+#include "placement.h"
+
+class SynapseStore;
+
+// Spärliche Eligibility-Traces für Drei-Faktor-Lernen: nur Synapsen mit einer
+// STDP-Koinzidenz in letzter Zeit haben einen Eintrag (Hash k -> Slot, Slots dicht).
+// Zerfall lazy: e gilt für `tick` und wird erst beim nächsten Zugriff heruntergerechnet.
+// Ein Reward kostet damit O(Einträge), nicht O(Synapsen).
+class EligibilityTraces {
+public:
+    struct Entry {
+        uint32_t k;          // Position im plastischen Store
+        int32_t  pre, post;  // für remap() nach Topologie-Änderungen
+        float    e;
+        long     tick;
+    };
+
+    // e auf `tick` bringen und de addieren (decay = Faktor pro Tick)
+    void add(uint32_t k, int pre, int post, float de, long tick, float decay);
+
+    // jeden Eintrag auf `tick` bringen, |e| < eps verwerfen, sonst fn(entry)
+    template <class F>
+    void visit(long tick, float decay, float eps, F&& fn) {
+        for (size_t i = 0; i < entries_.size(); ) {
+            Entry& x = entries_[i];
+            decay_to(x, tick, decay);
+            if (std::fabs(x.e) < eps) {
+                erase_at(i);      // letzter Eintrag rückt nach i -> i nicht erhöhen
+                continue;
+            }
+            fn(x);
+            ++i;
+        }
+    }
+
+    // Positionen haben sich verschoben (Pruning / Wachstum / Kompaktierung):
+    // k über (pre, post) neu suchen, verschwundene Synapsen fallen raus
+    void remap(const SynapseStore& s);
+
+    void   insert(const Entry& x);   // Checkpoint laden
+    void   clear();
+    size_t size() const { return entries_.size(); }
+    MemUse memory() const;   // Einträge + Hash-Index (Knoten geschätzt)
+    const std::vector<Entry>& entries() const { return entries_; }
+
+private:
+    static void decay_to(Entry& x, long tick, float decay) {
+        if (tick > x.tick) {
+            x.e *= std::pow(decay, static_cast<float>(tick - x.tick));
+            x.tick = tick;
+        }
+    }
+    void erase_at(size_t i);
+
+    std::unordered_map<uint32_t, uint32_t> slot_;
+    std::vector<Entry> entries_;
+};
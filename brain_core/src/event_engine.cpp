@@ -0,0 +1,116 @@
+#include "event_engine.h"
+#include "net.h"
+#include "binary_io.h"
+#include <cmath>
+#include <algorithm>
+
+void EventEngine::init(Net& net) {
+    const int N = net.neu.N;
+    last_tick.assign(N, 0);
+    ref_until.assign(N, -1);
+    touched_flag.assign(N, 0);
+    touched.clear();
+    spikes.clear();
+
+    max_rest_above_vth = -1.0f;
+    for (int i = 0; i < N; ++i)
+        max_rest_above_vth = std::max(max_rest_above_vth, net.neu.Vrest[i] - net.neu.Vth[i]);
+}
+
+MemUse EventEngine::memory() const {
+    MemUse m = mem_of(last_tick);
+    m += mem_of(ref_until);
+    m += mem_of(touched_flag);
+    m += mem_of(touched);
+    m += mem_of(spikes);
+    return m;
+}
+
+void EventEngine::touch(int i) {
+    if (!touched_flag[i]) {
+        touched_flag[i] = 1;
+        touched.push_back(i);
+    }
+}
+
+// Bringt V[i] von last_tick auf Tick t und verarbeitet den Input dieses Ticks.
+void EventEngine::update_neuron(Net& net, int i, long t) {
+    Neurons& n = net.neu;
+    const float I = n.Isyn[i];
+    n.Isyn[i] = 0.0f;
+
+    // Refraktär: Input verfällt, V bleibt auf Vreset
+    if (t <= ref_until[i]) return;
+
+    // geschlossener Zerfall über k Ticks, dann Input mit exaktem Propagator
+    const long  k = t - last_tick[i];
+    const float P = n.prop;
+    const float Pk = (k == 1) ? P : std::pow(P, static_cast<float>(k));
+    n.V[i] = n.Vrest[i] + (n.V[i] - n.Vrest[i]) * Pk + I * (1.0f - P);
+    last_tick[i] = t;
+
+    if (n.V[i] >= n.threshold(i)) {
+        const long n_ref = static_cast<long>(std::ceil(n.tref / n.dt - 1e-3f));
+        n.V[i] = n.Vreset[i];
+        ref_until[i] = t + n_ref;
+        last_tick[i] = ref_until[i];
+        n.mark_spike(i);
+        spikes.push_back(i);
+    }
+}
+
+void EventEngine::step(Net& net) {
+    const long t = net.tick;
+
+    // Spikes des letzten Ticks zurücksetzen (nur deren Bits, nicht den ganzen Vektor)
+    net.neu.clear_spikes();
+    spikes.clear();
+
+    // 1️⃣ fällige Events aus der Delay-Queue
+    net.dq.drain(t, [&](int post, float val) { net.add_input(post, val); });
+
+    // 2️⃣ externe Inputs (gehen über Net::add_input -> touch)
+    net.inject_inputs(net.neu.dt);
+
+    // 3️⃣ Neuronen aktualisieren: nur berührte, außer die Schwelle liegt unter Vrest
+    if (net.neu.vth_shift <= max_rest_above_vth) {
+        ++dense_ticks;
+        for (int i = 0; i < net.neu.N; ++i) update_neuron(net, i, t);
+    } else {
+        for (int i : touched) update_neuron(net, i, t);
+    }
+    for (int i : touched) touched_flag[i] = 0;
+    touched.clear();
+    // Verbraucher von neu.spikes (Readout, Beobachter, Sweep) erwarten aufsteigende IDs;
+    // Routing und STDP bleiben bei der Reihenfolge von `spikes`
+    std::sort(net.neu.spikes.begin(), net.neu.spikes.end());
+
+    // 4️⃣ STDP nur für Synapsen an spikenden Neuronen (vor dem Routing,
+    //    wie im Takt-Modus wird mit den schon gelernten Gewichten verteilt)
+    net.stdp_on_spikes(spikes);
+
+    // 5️⃣ Spikes verteilen. Ankunft wie im Takt-Modus: Tick t + 1 + delay
+    for (int pre : spikes) {
+        if (net.is_output[pre]) continue;
+        net.route_row(pre, t, t);
+    }
+}
+
+void EventEngine::save(std::ostream& o) const {
+    bio::put_vec(o, last_tick);
+    bio::put_vec(o, ref_until);
+    bio::put_vec(o, spikes);
+    bio::put(o, dense_ticks);
+    bio::put(o, max_rest_above_vth);
+}
+
+void EventEngine::load(std::istream& i) {
+    bio::get_vec(i, last_tick);
+    bio::get_vec(i, ref_until);
+    bio::get_vec(i, spikes);
+    bio::get(i, dense_ticks);
+    bio::get(i, max_rest_above_vth);
+    // touched ist zwischen zwei Ticks immer leer
+    touched_flag.assign(last_tick.size(), 0);
+    touched.clear();
+}
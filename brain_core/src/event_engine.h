@@ -0,0 +1,41 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <iosfwd>
+#include "placement.h"
+
+class Net;
+
+// Ereignisgetriebene Simulation für dünn feuernde Netze.
+// V[i] wird nur aktualisiert, wenn Neuron i Input bekommt: der Zerfall Richtung Vrest
+// wird dann für alle verpassten Ticks in geschlossener Form nachgeholt.
+// Verzögerte Spikes laufen über die gemeinsame Net::dq (DelayQueue).
+//
+// Einschränkung: Schwellen werden nur bei Input-Ankunft geprüft. Sinkt die
+// (hormonelle) Schwelle unter Vrest, feuern auch ruhende Neuronen – dann wird
+// der Tick dicht über alle Neuronen gerechnet.
+class EventEngine {
+public:
+    void init(Net& net);
+    void step(Net& net);
+
+    void touch(int i);                                // Neuron i hat in diesem Tick Input
+
+    void save(std::ostream& o) const;                 // Checkpoint
+    void load(std::istream& i);
+
+    MemUse memory() const;
+
+    std::vector<int> spikes;                          // Spikes des aktuellen Ticks
+    long dense_ticks = 0;                             // Ticks im dichten Fallback
+
+private:
+    void update_neuron(Net& net, int i, long t);
+
+    std::vector<long>    last_tick;   // bis zu diesem Tick ist V[i] aktuell
+    std::vector<long>    ref_until;   // letzter Refraktär-Tick
+    std::vector<uint8_t> touched_flag;
+    std::vector<int>     touched;
+
+    float max_rest_above_vth = 0.0f;  // max_i (Vrest[i] - Vth[i]) für den Fallback-Test
+};
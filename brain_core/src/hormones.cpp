@@ -1,15 +1,16 @@
 #include "hormones.h"
 #include <cmath>
-#include <cstdlib> // für rand()
 
-// Zufallszahl zwischen min und max
-static float random_range(float min, float max) {
-    return min + static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / (max - min)));
+// Zufallszahl zwischen min und max (deterministisch aus dem Generator)
+static float random_range(std::mt19937& rng, float min, float max) {
+    return min + (max - min) * (static_cast<float>(rng() >> 8) * (1.0f / 16777216.0f));
 }
 
-// Lineare Interpolation (Sanftes Gleiten)
-static float lerp(float current, float target, float speed, float dt) {
-    return current + (target - current) * speed * dt;
+// Sanftes Gleiten zum Ziel: exakte Lösung von dx/dt = speed * (target - x).
+// alpha = 1 - exp(-speed * dt), damit ist das Ergebnis unabhängig davon,
+// ob update() jede ms oder nur alle 100 ms aufgerufen wird.
+static float approach(float current, float target, float alpha) {
+    return current + (target - current) * alpha;
 }
 
 HormoneSystem::HormoneSystem() {
@@ -50,10 +51,10 @@ void HormoneSystem::update(float dt) {
 
     if (event_timer <= 0.0f) {
         // Neuen Timer setzen (Random 2 bis 7 Sekunden)
-        event_timer = random_range(2.0f, 7.0f);
+        event_timer = random_range(rng, 2.0f, 7.0f);
 
         // ENTSCHEIDUNG: Zurück zur Basis oder Chaos?
-        float dice = random_range(0.0f, 1.0f);
+        float dice = random_range(rng, 0.0f, 1.0f);
 
         if (dice < 0.4f) {
             // 40% Chance: "Reset to Base" (Rick fängt sich wieder)
@@ -61,16 +62,16 @@ void HormoneSystem::update(float dt) {
         } 
         else if (dice < 0.7f) {
             // 30% Chance: Leichte Variation (Tagesform)
-            target.dopamine      = base_config.dopamine      + random_range(-0.1f, 0.2f);
-            target.serotonin     = base_config.serotonin     + random_range(-0.1f, 0.1f);
-            target.adrenaline    = base_config.adrenaline    + random_range(-0.05f, 0.2f);
-            target.acetylcholine = base_config.acetylcholine + random_range(-0.1f, 0.1f);
+            target.dopamine      = base_config.dopamine      + random_range(rng, -0.1f, 0.2f);
+            target.serotonin     = base_config.serotonin     + random_range(rng, -0.1f, 0.1f);
+            target.adrenaline    = base_config.adrenaline    + random_range(rng, -0.05f, 0.2f);
+            target.acetylcholine = base_config.acetylcholine + random_range(rng, -0.1f, 0.1f);
             // Rest bleibt grob gleich
         } 
         else {
             // 30% Chance: Starker "Micro-Mood" (Zufälliger Impuls)
             // Wir würfeln EINEN starken emotionalen Zustand
-            int mood = rand() % 4;
+            int mood = static_cast<int>(rng() % 4);
             switch(mood) {
                 case 0: // "Eureka!" (Idee)
                     target.dopamine = 0.9f; target.acetylcholine = 0.95f; target.adrenaline = 0.5f;
@@ -103,21 +104,22 @@ void HormoneSystem::update(float dt) {
     if (effective_target.cortisol > 0.5f) effective_target.serotonin *= 0.5f;
 
 
-    // 3. BEWEGUNG (Lerp)
+    // 3. BEWEGUNG (exponentiell, closed form)
     // Wir bewegen uns vom 'current' zum 'effective_target'.
     // speed bestimmt, wie träge das System ist.
     float speed = 0.05f; // Ziemlich zügig reagieren
+    const float alpha = static_cast<float>(-std::expm1(-static_cast<double>(speed) * dt));
 
-    current.dopamine      = lerp(current.dopamine,      effective_target.dopamine,      speed, dt);
-    current.serotonin     = lerp(current.serotonin,     effective_target.serotonin,     speed, dt);
-    current.cortisol      = lerp(current.cortisol,      effective_target.cortisol,      speed, dt);
-    current.adrenaline    = lerp(current.adrenaline,    effective_target.adrenaline,    speed, dt);
-    current.oxytocin      = lerp(current.oxytocin,      effective_target.oxytocin,      speed, dt);
-    current.melatonin     = lerp(current.melatonin,     effective_target.melatonin,     speed, dt);
-    current.noradrenaline = lerp(current.noradrenaline, effective_target.noradrenaline, speed, dt);
-    current.endorphin     = lerp(current.endorphin,     effective_target.endorphin,     speed, dt);
-    current.acetylcholine = lerp(current.acetylcholine, effective_target.acetylcholine, speed, dt);
-    current.testosterone  = lerp(current.testosterone,  effective_target.testosterone,  speed, dt);
+    current.dopamine      = approach(current.dopamine,      effective_target.dopamine,      alpha);
+    current.serotonin     = approach(current.serotonin,     effective_target.serotonin,     alpha);
+    current.cortisol      = approach(current.cortisol,      effective_target.cortisol,      alpha);
+    current.adrenaline    = approach(current.adrenaline,    effective_target.adrenaline,    alpha);
+    current.oxytocin      = approach(current.oxytocin,      effective_target.oxytocin,      alpha);
+    current.melatonin     = approach(current.melatonin,     effective_target.melatonin,     alpha);
+    current.noradrenaline = approach(current.noradrenaline, effective_target.noradrenaline, alpha);
+    current.endorphin     = approach(current.endorphin,     effective_target.endorphin,     alpha);
+    current.acetylcholine = approach(current.acetylcholine, effective_target.acetylcholine, alpha);
+    current.testosterone  = approach(current.testosterone,  effective_target.testosterone,  alpha);
 
     // 4. CLIPPING (Sicherheit)
     // Werte zwischen 0.01 und 0.99 halten
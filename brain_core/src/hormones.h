@@ -1,5 +1,6 @@
 #pragma once
 #include <algorithm>
+#include <random>
 
 struct HormoneSet {
     float dopamine = 0.0f;
@@ -28,10 +29,13 @@ public:
     // Timer für den nächsten Stimmungsschwank
     float event_timer = 0.0f;
 
+    // eigener Zufallsgenerator (statt rand()), damit Läufe reproduzierbar sind
+    std::mt19937 rng{7};
+
     // Konstruktor: Setzt Rick als Standard
     HormoneSystem();
 
-    // Update Loop
+    // Update Loop. dt darf auch eine grobe Periode sein (z.B. 50 ms), die Bewegung ist exakt.
     void update(float dt);
 
     // Inputs vom SNN (Drives)
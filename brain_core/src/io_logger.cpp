@@ -17,7 +17,8 @@ void IoLogger::clear_all_io_files() {
     std::vector<std::string> files = {
         "./../../io/out/spikes.jsonl",
         "./../../io/out/log.jsonl",
-        "./../../io/out/stats.jsonl"
+        "./../../io/out/stats.jsonl",
+        "./../../io/out/tokens.jsonl"
     };
 
     for (const auto& f : files) {
@@ -79,10 +80,12 @@ void IoLogger::open(const std::string& dir) {
     spikes_path_ = (fs::path(dir) / "spikes.jsonl").string();
     log_path_    = (fs::path(dir) / "log.jsonl").string();
     stats_path_  = (fs::path(dir) / "stats.jsonl").string();
+    tokens_path_ = (fs::path(dir) / "tokens.jsonl").string();
 
     spikes_.open(spikes_path_, std::ios::out | std::ios::app);
     log_.open(log_path_,       std::ios::out | std::ios::app);
     stats_.open(stats_path_,   std::ios::out | std::ios::app);
+    tokens_.open(tokens_path_, std::ios::out | std::ios::app);
 
     fd_spikes_ = ::open(spikes_path_.c_str(), O_WRONLY | O_APPEND);
     fd_log_    = ::open(log_path_.c_str(),    O_WRONLY | O_APPEND);
@@ -142,7 +145,7 @@ void IoLogger::log_spike_matrix(const std::vector<uint8_t>& spikes, int timestep
     stats_.open(stats_path_, std::ios::out | std::ios::app);
 }
 
-void IoLogger::log_spike(const HormoneSystem* H, int timestep, int spike_count) {
+void IoLogger::log_spike(const HormoneSet* H, int timestep, int spike_count, const std::vector<float>* probe_V) {
     std::lock_guard<std::mutex> lock(mtx_);
     if (!spikes_.is_open()) return;
 
@@ -162,16 +165,16 @@ void IoLogger::log_spike(const HormoneSystem* H, int timestep, int spike_count)
 
         // Nur die Hormone werden formatiert als Strings
         j["hormones"] = {
-            {"dopamine",      fmt2(H->current.dopamine)},
-            {"serotonin",     fmt2(H->current.serotonin)},
-            {"cortisol",      fmt2(H->current.cortisol)},
-            {"adrenaline",    fmt2(H->current.adrenaline)},
-            {"oxytocin",      fmt2(H->current.oxytocin)},
-            {"melatonin",     fmt2(H->current.melatonin)},
-            {"noradrenaline", fmt2(H->current.noradrenaline)},
-            {"endorphin",     fmt2(H->current.endorphin)},
-            {"acetylcholine", fmt2(H->current.acetylcholine)},
-            {"testosterone",  fmt2(H->current.testosterone)}
+            {"dopamine",      fmt2(H->dopamine)},
+            {"serotonin",     fmt2(H->serotonin)},
+            {"cortisol",      fmt2(H->cortisol)},
+            {"adrenaline",    fmt2(H->adrenaline)},
+            {"oxytocin",      fmt2(H->oxytocin)},
+            {"melatonin",     fmt2(H->melatonin)},
+            {"noradrenaline", fmt2(H->noradrenaline)},
+            {"endorphin",     fmt2(H->endorphin)},
+            {"acetylcholine", fmt2(H->acetylcholine)},
+            {"testosterone",  fmt2(H->testosterone)}
         };
     }
 
@@ -180,6 +183,7 @@ void IoLogger::log_spike(const HormoneSystem* H, int timestep, int spike_count)
     j["type"] = "spike";
     j["timestep"] = timestep;
     j["spikes"] = spike_count;
+    if (probe_V && !probe_V->empty()) j["V"] = *probe_V;   // --probe-Neuronen
 
     // Schreiben ins File (normal, kein Pretty-Print)
     spikes_ << j.dump() << "\n";
@@ -209,6 +213,17 @@ void IoLogger::log_error(const std::string& msg) {
     trim_file_to_last_lines(log_path_, 100);
 }
 
+void IoLogger::log_memory(const nlohmann::json& report) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (!log_.is_open()) return;
+    json j = { {"ts", now_iso_utc()}, {"type","memory"} };
+    j.update(report);
+    log_ << j.dump() << "\n";
+    log_.flush();
+    if (fd_log_ >= 0) fsync(fd_log_);
+    trim_file_to_last_lines(log_path_, 100);
+}
+
 void IoLogger::log_hormone(const std::string& name, float level) {
     std::lock_guard<std::mutex> lock(mtx_);
     if (!log_.is_open()) return;                 // vorerst in log.jsonl
@@ -219,3 +234,15 @@ void IoLogger::log_hormone(const std::string& name, float level) {
     trim_file_to_last_lines(log_path_, 100);
 }
 
+
+// Dekodierte Tokens: sofort flushen (Latenz ~ 1 Tick), ohne fsync. Gekürzt wird
+// nur alle 1000 Tokens – der Coach liest ab seinem letzten Tick.
+void IoLogger::log_token(long timestep, const std::string& token, int output, int neuron, int count) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (!tokens_.is_open()) return;
+    json j = { {"ts", now_iso_utc()}, {"type","token"}, {"timestep", timestep}, {"token", token},
+               {"output", output}, {"neuron", neuron}, {"count", count} };
+    tokens_ << j.dump() << "\n";
+    tokens_.flush();
+    if (++tokens_written_ % 1000 == 0) trim_file_to_last_lines(tokens_path_, 1000);
+}
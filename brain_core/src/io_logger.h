@@ -13,18 +13,21 @@ public:
     void open(const std::string& dir = "./../../io/out/");
     void clear_log_file(const std::string& path);
     void log_spike_matrix(const std::vector<uint8_t>& spikes, int timestep);
-    void log_spike(const HormoneSystem* H, int timestep, int spike_count);
+    void log_spike(const HormoneSet* H, int timestep, int spike_count, const std::vector<float>* probe_V = nullptr);
     void log_status(const std::string& msg);
     void log_error(const std::string& msg);
+    void log_memory(const nlohmann::json& report);   // Speicherbilanz (memory_report.h)
     void log_hormone(const std::string& name, float level);
+    void log_token(long timestep, const std::string& token, int output, int neuron, int count);
     void clear_all_io_files();
     void set_layer_info(int n_inputs, int n_outputs);
 
 private:
-    std::ofstream spikes_, log_, stats_;
+    std::ofstream spikes_, log_, stats_, tokens_;
     int fd_spikes_ = -1, fd_log_ = -1, fd_stats_ = -1;
     std::mutex mtx_;
-    std::string spikes_path_, log_path_, stats_path_;
+    std::string spikes_path_, log_path_, stats_path_, tokens_path_;
     int n_inputs_  = 0;
     int n_outputs_ = 0;
+    long tokens_written_ = 0;
 };
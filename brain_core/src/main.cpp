@@ -14,26 +14,40 @@
 #include <nlohmann/json.hpp>
 #include <fstream>
 #include <sys/stat.h>
+#include <filesystem>
+#include <cstdio>
+#include <memory>
+#include <algorithm>
 
 #include "net.h"
+#include "network_builder.h"
 #include "io_logger.h"
+#include "commands.h"
+#include "checkpoint.h"
+#include "sweep.h"
+#include "cluster.h"
+#include "telemetry.h"
+#include "observer.h"
+#include "memory_report.h"
 
 static std::atomic<bool> running{true};
 static void on_sigint(int){ running = false; }
 
 
-void process_commands(Net& net) {
+// Neue Zeilen aus commands.jsonl seit dem letzten Aufruf
+static std::vector<nlohmann::json> read_new_commands() {
     static std::string path = "./../io/in/commands.jsonl";
     static off_t last_size = 0;
+    std::vector<nlohmann::json> out;
 
     struct stat st;
-    if (stat(path.c_str(), &st) != 0) return;
+    if (stat(path.c_str(), &st) != 0) return out;
 
     if (st.st_size <= last_size)
-        return;
+        return out;
 
     std::ifstream f(path, std::ios::in);
-    if (!f.is_open()) return;
+    if (!f.is_open()) return out;
 
     f.seekg(last_size);
     std::string line;
@@ -41,41 +55,141 @@ void process_commands(Net& net) {
     while (std::getline(f, line)) {
         if (line.empty()) continue;
         try {
-            auto j = nlohmann::json::parse(line);
-            std::string cmd = j.value("cmd", "");
+            out.push_back(nlohmann::json::parse(line));
+        }
+        catch (std::exception& e) {
+            IoLogger::instance().log_error(std::string("Command parse error: ") + e.what());
+        }
+    }
 
-            // Unterstütze neues Format mit data-Objekt
-            nlohmann::json data = j.contains("data") ? j["data"] : j;
+    last_size = st.st_size;
+    return out;
+}
 
-            if (cmd == "set_hormones") {
-                if (data.contains("dopamine"))
-                    net.H.set_dopamine_drive(data["dopamine"]);
-                if (data.contains("cortisol"))
-                    net.H.set_cortisol_drive(data["cortisol"]);
-                if (data.contains("adrenaline"))
-                    net.H.set_adrenaline_drive(data["adrenaline"]);
+// Befehl anwenden und mit dem aktuellen Tick protokollieren
+static void apply_logged(Net& net, CommandLog& cmd_log, const nlohmann::json& j) {
+    std::string cmd = j.value("cmd", "");
 
-                IoLogger::instance().log_status("🧠 Hormone drives updated via command");
-            }
-            else if (cmd == "input_pattern" || cmd == "input") {
-                auto pattern = data.value("pattern", std::vector<int>{});
-                if (!pattern.empty()) {
-                    net.external_input_pattern.assign(pattern.begin(), pattern.end());
-                    net.external_input_active = true;
-                    IoLogger::instance().log_status("🧠 External input pattern applied");
+    // Unterstütze neues Format mit data-Objekt
+    nlohmann::json data = j.contains("data") ? j["data"] : j;
+
+    cmd_log.record(net.tick, cmd, data);
+    try {
+        if (!apply_command(net, cmd, data))
+            running = false;
+    }
+    catch (std::exception& e) {
+        IoLogger::instance().log_error(std::string("Command error: ") + e.what());
+    }
+}
+
+void process_commands(Net& net, CommandLog& cmd_log) {
+    for (const auto& j : read_new_commands())
+        apply_logged(net, cmd_log, j);
+}
+
+// Replay: Checkpoint laden, protokollierte Befehle im selben Tick anwenden,
+// ohne Echtzeit-Takt und ohne Logger so schnell wie möglich rechnen.
+static int run_replay(Net& net, const std::string& log_path, const std::string& from, long steps, bool steps_given) {
+    try {
+        if (!from.empty()) load_checkpoint(net, from);
+
+        long end_tick = -1;
+        const auto cmds = load_command_log(log_path, end_tick);
+        if (steps_given) end_tick = net.tick + steps;
+        if (end_tick < 0) {
+            std::cerr << "❌ Log hat kein Ende (abgebrochener Lauf?) – bitte --steps angeben\n";
+            return 1;
+        }
+
+        const long start_tick = net.tick;
+        size_t next = 0;
+        while (next < cmds.size() && cmds[next].tick < net.tick) ++next;
+
+        const auto t0 = std::chrono::steady_clock::now();
+        size_t n_errors = 0;
+        while (running && net.tick < end_tick) {
+            for (; next < cmds.size() && cmds[next].tick == net.tick; ++next) {
+                // wie apply_logged: fehlerhafte Befehle stehen auch im Log, melden und weiter
+                try {
+                    apply_command(net, cmds[next].cmd, cmds[next].data);
+                } catch (const std::exception& e) {
+                    ++n_errors;
+                    std::cerr << "⚠️  Tick " << net.tick << ", Befehl " << cmds[next].cmd << ": " << e.what() << "\n";
                 }
             }
-            else if (cmd == "exit") {
-                IoLogger::instance().log_status("🛑 Exit command received");
-                running = false;
-            }
+            net.step_once(0.0f);
+            net.readout.decoded.clear();
         }
-        catch (std::exception& e) {
-            IoLogger::instance().log_error(std::string("Command parse error: ") + e.what());
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        const double sim_ms = (net.tick - start_tick) * net.neu.dt * 1000.0;
+
+        std::cout << "▶️  Replay Tick " << start_tick << " -> " << net.tick << ": " << std::fixed << std::setprecision(1)
+                  << ms << " ms (" << (ms > 0.0 ? sim_ms / ms : 0.0) << "x Echtzeit), "
+                  << (next) << " Befehle" << (n_errors ? " (" + std::to_string(n_errors) + " fehlerhaft)" : "")
+                  << "\n"
+                  << "State-Hash: " << std::hex << state_hash(net) << std::dec << "\n";
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Replay: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+// Mehrere Prozesse (--procs): jeder rechnet seine Partition, an jeder Intervallgrenze
+// werden Spikes getauscht. Rank 0 liest Befehle, loggt und dekodiert Tokens; Befehle
+// und Stopp gelten für alle ab dem ersten Tick nach der Grenze.
+static int run_partitioned(Net& net, Cluster& cluster, CommandLog& cmd_log, long steps, bool realtime,
+                           long print_every_steps) {
+    const bool is_root = cluster.rank == 0;
+    const auto t0 = std::chrono::steady_clock::now();
+    try {
+        for (;;) {
+            net.step_once(0.0f);
+            cluster.after_tick(net);
+            if (!cluster.due(net.tick)) continue;
+
+            std::vector<nlohmann::json> cmds;
+            bool stop_all = false;
+            if (is_root) {
+                cmds = read_new_commands();
+                stop_all = !running || (steps >= 0 && net.tick >= steps);
+            }
+            cluster.exchange(net, cmds, stop_all);
+            for (const auto& j : cluster.commands)
+                apply_logged(net, cmd_log, j);
+
+            if (is_root) {
+                for (const auto& tk : net.readout.decoded)
+                    IoLogger::instance().log_token(tk.tick, tk.text, tk.output, tk.neuron, tk.count);
+                for (size_t j = 0; j < cluster.tick_spikes.size(); ++j) {
+                    const long s = cluster.interval_begin + static_cast<long>(j);
+                    if (s % print_every_steps == 0)
+                        IoLogger::instance().log_spike(&net.H.current, s, static_cast<int>(cluster.tick_spikes[j]));
+                }
+                if (realtime)
+                    std::this_thread::sleep_until(t0 + std::chrono::duration<double>(net.tick * net.neu.dt));
+            }
+            net.readout.decoded.clear();
+            if (cluster.stop) break;
         }
+    } catch (const std::exception& e) {
+        if (!is_root) _exit(1);
+        IoLogger::instance().log_error(std::string("Partitionen: ") + e.what());
+        return 1;
     }
 
-    last_size = st.st_size;
+    const uint64_t h = cluster.gather_hash(state_hash(net));
+    if (!is_root) _exit(0);       // keine Destruktoren/Puffer des Eltern-Prozesses doppelt ausführen
+
+    cmd_log.close(net.tick);
+    std::ostringstream hash;
+    hash << std::hex << h;
+    IoLogger::instance().log_status("🧩 " + std::to_string(cluster.n_sent) + " Spike-IDs von Partition 0 verschickt");
+    IoLogger::instance().log_status("🔏 Tick " + std::to_string(net.tick) + ", State-Hash " + hash.str()
+                                    + " (" + std::to_string(cluster.size) + " Prozesse)");
+    IoLogger::instance().log_status("Brain stopped");
+    return 0;
 }
 
 int main(int argc, char** argv) {
@@ -91,15 +205,40 @@ int main(int argc, char** argv) {
     std::signal(SIGINT, on_sigint);
     // Defaults
     long   steps = 2000;       // 2 s bei dt=1 ms
+    bool   steps_given = false;
     double seconds = -1.0;     // wenn >=0, überschreibt steps
     int    print_every_ms = 100;
     bool   realtime = false;
+    WeightFormat weight_format = WeightFormat::F32;
+    Engine engine = Engine::Clock;
+    double dt_ms = 1.0;
+    std::string net_spec_path;
+    double hormone_period_ms = 1.0;
+    double modulation_period_ms = 1.0;
+    double structural_period_ms = 0.0;
+    Readout::Mode readout_mode = Readout::Mode::WTA;
+    double readout_window_ms = 50.0;
+    int    readout_threshold = 3;
+    std::string replay_path, replay_from;
+    double checkpoint_every_ms = 0.0;
+    int    threads = 1;
+    bool   pin_threads = true;
+    int    procs = 1;
+    std::string telemetry_path, telemetry_query, query_columns;
+    double telemetry_every_ms = 1000.0;
+    int64_t query_from = INT64_MIN, query_to = INT64_MAX;
+    Plasticity plasticity = Plasticity::STDP;
+    double eligibility_tau_ms = 1000.0;
+    float  reward_lr = 1.0f;
+    std::vector<int> probe_ids;
+    bool   dry_run = false;
 
     // CLI
     for (int i=1; i<argc; ++i) {
         std::string a = argv[i];
         if ((a=="--steps" || a=="-n") && i+1<argc) {
             steps = std::stol(argv[++i]);
+            steps_given = true;
         } else if ((a=="--seconds" || a=="-s") && i+1<argc) {
             seconds = std::stod(argv[++i]);
         } else if ((a=="--print-every-ms" || a=="-p") && i+1<argc) {
@@ -107,27 +246,226 @@ int main(int argc, char** argv) {
             if (print_every_ms < 1) print_every_ms = 1;
         } else if (a=="--realtime") {
             realtime = true;
+        } else if (a=="--engine" && i+1<argc) {
+            std::string e = argv[++i];
+            if (e == "event") engine = Engine::Event;
+            else if (e == "clock") engine = Engine::Clock;
+            else { std::cerr << "Unbekannte Engine: " << e << "\n"; return 1; }
+        } else if (a=="--net" && i+1<argc) {
+            net_spec_path = argv[++i];
+        } else if (a=="--dt-ms" && i+1<argc) {
+            dt_ms = std::stod(argv[++i]);
+        } else if (a=="--hormone-period-ms" && i+1<argc) {
+            hormone_period_ms = std::stod(argv[++i]);
+        } else if (a=="--modulation-period-ms" && i+1<argc) {
+            modulation_period_ms = std::stod(argv[++i]);
+        } else if (a=="--structural-period-ms" && i+1<argc) {
+            structural_period_ms = std::stod(argv[++i]);
+        } else if (a=="--readout" && i+1<argc) {
+            std::string m = argv[++i];
+            if (m == "wta") readout_mode = Readout::Mode::WTA;
+            else if (m == "threshold") readout_mode = Readout::Mode::Threshold;
+            else { std::cerr << "Unbekannter Readout: " << m << "\n"; return 1; }
+        } else if (a=="--readout-window-ms" && i+1<argc) {
+            readout_window_ms = std::stod(argv[++i]);
+        } else if (a=="--readout-threshold" && i+1<argc) {
+            readout_threshold = std::stoi(argv[++i]);
+        } else if (a=="--replay" && i+1<argc) {
+            replay_path = argv[++i];
+        } else if (a=="--from" && i+1<argc) {
+            replay_from = argv[++i];
+        } else if (a=="--checkpoint-every-ms" && i+1<argc) {
+            checkpoint_every_ms = std::stod(argv[++i]);
+        } else if (a=="--sweep" && i+1<argc) {
+            return run_sweep(argv[++i]);
+        } else if (a=="--threads" && i+1<argc) {
+            threads = std::max(1, std::stoi(argv[++i]));
+        } else if (a=="--procs" && i+1<argc) {
+            procs = std::max(1, std::stoi(argv[++i]));
+        } else if (a=="--no-pin") {
+            pin_threads = false;
+        } else if (a=="--dry-run") {
+            dry_run = true;
+        } else if (a=="--huge-pages" && i+1<argc) {
+            set_huge_pages(parse_huge_pages(argv[++i]));
+        } else if (a=="--telemetry" && i+1<argc) {
+            telemetry_path = argv[++i];
+        } else if (a=="--telemetry-every-ms" && i+1<argc) {
+            telemetry_every_ms = std::stod(argv[++i]);
+        } else if (a=="--telemetry-query" && i+1<argc) {
+            telemetry_query = argv[++i];
+        } else if (a=="--query-from" && i+1<argc) {
+            query_from = std::stoll(argv[++i]);
+        } else if (a=="--query-to" && i+1<argc) {
+            query_to = std::stoll(argv[++i]);
+        } else if (a=="--query-columns" && i+1<argc) {
+            query_columns = argv[++i];
+        } else if (a=="--plasticity" && i+1<argc) {
+            std::string m = argv[++i];
+            if (m == "stdp") plasticity = Plasticity::STDP;
+            else if (m == "reward") plasticity = Plasticity::Reward;
+            else { std::cerr << "Unbekannte Lernregel: " << m << "\n"; return 1; }
+        } else if (a=="--eligibility-tau-ms" && i+1<argc) {
+            eligibility_tau_ms = std::stod(argv[++i]);
+        } else if (a=="--reward-lr" && i+1<argc) {
+            reward_lr = std::stof(argv[++i]);
+        } else if (a=="--probe" && i+1<argc) {
+            std::stringstream ss(argv[++i]);
+            for (std::string id; std::getline(ss, id, ',');)
+                if (!id.empty()) probe_ids.push_back(std::stoi(id));
+        } else if (a=="--weights" && i+1<argc) {
+            weight_format = parse_weight_format(argv[++i]);
         } else if (a=="--help" || a=="-h") {
             std::cout <<
-            "Usage: ./brain [--steps N|-n N] [--seconds S|-s S] [--print-every-ms M|-p M] [--realtime]\n"
+            "Usage: ./brain [--steps N|-n N] [--seconds S|-s S] [--print-every-ms M|-p M] [--realtime] [--net FILE] [--engine E] [--dt-ms X] [--weights F]\n"
             "  --steps N        : simuliere N Schritte (1 Schritt = dt Sekunden). N<0 => endlos bis Ctrl+C.\n"
             "  --seconds S      : simuliere ~S Sekunden (überschreibt --steps).\n"
             "  --print-every-ms M : Log alle M Millisekunden Simulationszeit (Default 200).\n"
             "  --realtime       : simuliere im Echtzeit-Takt (Accumulator).\n"
+            "  --net FILE       : Netz aus JSON-Spec bauen (Populationen/Projektionen, z.B. config/demo_net.json).\n"
+            "  --engine E       : clock (Default, jeder Tick alle Neuronen) | event (nur Neuronen mit Input).\n"
+            "  --dt-ms X        : Zeitschritt in ms (Default 1; exakter LIF-Propagator erlaubt größere).\n"
+            "  --hormone-period-ms X    : Hormone nur alle X ms rechnen (Default 1, closed form).\n"
+            "  --modulation-period-ms X : Hormon-Modulation der Neuronen alle X ms (Default 1).\n"
+            "  --structural-period-ms X : alle X ms Synapsen abbauen/neu bilden (Default 0 = aus).\n"
+            "  --readout M      : Output-Dekodierung wta (Default) | threshold -> io/out/tokens.jsonl.\n"
+            "  --readout-window-ms X    : gleitendes Zählfenster der Output-Neuronen (Default 50).\n"
+            "  --readout-threshold K    : min. Spikes im Fenster für ein Token (Default 3).\n"
+            "  --checkpoint-every-ms X  : alle X ms Checkpoint nach io/out/checkpoints/ (Default 0 = aus).\n"
+            "  --replay LOG     : Lauf aus io/out/commands_applied.jsonl nachrechnen (max. Tempo, ohne Logs).\n"
+            "  --from CKPT      : Start-Checkpoint für --replay (sonst ab Tick 0). Netz-Argumente wie im Original.\n"
+            "  --sweep SPEC     : Parameter-Sweep (Gitter/Zufall) parallel auf allen Kernen -> CSV, dann Ende.\n"
+            "  --threads N      : Neuronen-Partitionen / Worker im Takt-Modus (Default 1).\n"
+            "  --no-pin         : Worker nicht an CPU-Kerne pinnen.\n"
+            "  --procs N        : Netz auf N Prozesse verteilen (Shared Memory, nur Takt-Modus).\n"
+            "  --huge-pages M   : off | thp (Default) | 2m | 1g für große Zustands-Arrays.\n"
+            "  --dry-run        : Speicherbedarf aus --net vorhersagen (ohne Aufbau), dann Ende.\n"
+            "  --telemetry FILE : Hormone, Spikes pro Population, Schrittzeit komprimiert anhängen.\n"
+            "  --telemetry-every-ms X   : Abtastung der Telemetrie (Default 1000).\n"
+            "  --telemetry-query FILE   : Telemetrie als CSV ausgeben, dann Ende\n"
+            "                     [--query-from MS] [--query-to MS] (Unix-ms) [--query-columns a,b].\n"
+            "  --plasticity R   : stdp (Default, sofort aufs Gewicht) | reward (Drei-Faktor: STDP lädt\n"
+            "                     Eligibility-Traces, Befehl \"reward\" macht daraus Gewichtsänderungen).\n"
+            "  --eligibility-tau-ms X   : Zerfall der Eligibility-Traces (Default 1000).\n"
+            "  --reward-lr X    : dw = X * Reward * Eligibility (Default 1).\n"
+            "  --probe IDS      : Membranspannung dieser Neuronen (kommagetrennt) in spikes.jsonl (\"V\").\n"
+            "  --weights F      : Gewichtsformat f32|f16|i8 (Default f32; f16/i8 sparen Speicher,\n"
+            "                     verschlucken aber sehr kleine STDP-Schritte).\n"
             "Ctrl+C beendet sauber.\n";
             return 0;
         }
     }
 
+    if (!telemetry_query.empty())
+        return run_telemetry_query(telemetry_query, query_from, query_to, query_columns);
+
+    if (dry_run) {
+        if (net_spec_path.empty()) {
+            std::cerr << "❌ --dry-run braucht --net\n";
+            return 1;
+        }
+        try {
+            std::cout << predict_memory(load_net_spec(net_spec_path), weight_format, engine,
+                                        structural_period_ms > 0.0,
+                                        std::max(1, static_cast<int>(std::lround(readout_window_ms / dt_ms)))).table();
+        } catch (const std::exception& e) {
+            std::cerr << "❌ Netz-Spec: " << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    if (procs > 1 && (engine != Engine::Clock || structural_period_ms > 0.0 || !replay_path.empty()
+                      || checkpoint_every_ms > 0.0 || !telemetry_path.empty() || plasticity != Plasticity::STDP)) {
+        std::cerr << "❌ --procs geht nur im Takt-Modus, ohne Struktur-Plastizität, Replay, Checkpoints, Telemetrie"
+                     " und --plasticity reward\n";
+        return 1;
+    }
+
     // Netz aufbauen
     Net net;
-    const int N = 50, FAN_IN = 30, Input_Neurons = 10, Output_Neurons = 10;
-    net.build_small_demo(N, FAN_IN, Input_Neurons, Output_Neurons);
-    IoLogger::instance().set_layer_info(Input_Neurons, Output_Neurons);
+    net.weight_format = weight_format;
+    net.engine = engine;
+    net.threads = (procs > 1) ? 1 : threads;     // Worker-Threads erst nach dem fork
+    net.pin_threads = pin_threads;
+    net.neu.dt = static_cast<float>(dt_ms / 1000.0);
+    auto period_ticks = [&](double ms) { return std::max(1, static_cast<int>(std::lround(ms / dt_ms))); };
+    net.hormone_rate.period    = period_ticks(hormone_period_ms);
+    net.modulation_rate.period = period_ticks(modulation_period_ms);
+    net.structural_on          = structural_period_ms > 0.0;
+    net.structural_rate.period = period_ticks(structural_period_ms);
+    net.plasticity = plasticity;
+    net.tau_elig   = static_cast<float>(eligibility_tau_ms / 1000.0);
+    net.reward_lr  = reward_lr;
+    net.readout.mode      = readout_mode;
+    net.readout.window    = period_ticks(readout_window_ms);
+    net.readout.threshold = readout_threshold;
+    auto build_start = std::chrono::steady_clock::now();
+    if (!net_spec_path.empty()) {
+        try {
+            net.build_from_spec(load_net_spec(net_spec_path));
+        } catch (const std::exception& e) {
+            std::cerr << "❌ Netz-Spec: " << e.what() << "\n";
+            return 1;
+        }
+    } else {
+        const int N = 50, FAN_IN = 30, Input_Neurons = 10, Output_Neurons = 10;
+        net.build_small_demo(N, FAN_IN, Input_Neurons, Output_Neurons);
+    }
+    const double build_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - build_start).count();
+
+    // seconds -> steps (dt aus dem Netz)
+    if (seconds >= 0.0) {
+        steps = static_cast<long>(seconds / net.neu.dt);
+        steps_given = true;
+    }
+
+    if (!replay_path.empty())
+        return run_replay(net, replay_path, replay_from, steps, steps_given);
+
+    // Partitionen: gebautes Netz wird per fork geteilt, jeder Prozess behält seinen Teil
+    Cluster cluster;
+    if (procs > 1) {
+        try {
+            cluster.launch(procs);
+            cluster.partition(net, threads);
+        } catch (const std::exception& e) {
+            std::cerr << "❌ Partitionen: " << e.what() << "\n";
+            if (cluster.rank != 0) _exit(1);
+            return 1;
+        }
+        if (cluster.rank != 0) {
+            CommandLog no_log;
+            return run_partitioned(net, cluster, no_log, steps, false, 1);
+        }
+    }
+
+    IoLogger::instance().set_layer_info(net.n_inputs, net.n_outputs);
 
     //Logger Öffnen
     IoLogger::instance().open("./../../io/out/");
-    IoLogger::instance().log_status("Brain initialized");
+    IoLogger::instance().log_status("Brain initialized: " + std::to_string(net.neu.N) + " Neuronen, "
+                                    + std::to_string(net.n_synapses()) + " Synapsen ("
+                                    + std::to_string(net.syn.size()) + " plastisch"
+                                    + (net.n_procedural ? ", " + std::to_string(net.n_procedural) + " prozedural" : "")
+                                    + "), Aufbau "
+                                    + std::to_string(static_cast<long>(build_ms)) + " ms");
+    {
+        const PlacementStats ps = placement_stats();
+        const char* hp[] = { "off", "thp", "2m", "1g" };
+        IoLogger::instance().log_status("🧮 Zustands-Arrays: " + std::to_string(ps.bytes >> 10) + " KB, "
+                                        + std::to_string(ps.mapped_regions) + " mmap-Regionen, Huge Pages "
+                                        + hp[static_cast<int>(huge_pages())]
+                                        + (ps.huge_fallbacks ? " (kein Vorrat, Fallback auf THP)" : "")
+                                        + ", " + std::to_string(net.threads) + " Worker");
+        const MemoryReport mr = memory_report(net);
+        char bps[16];
+        std::snprintf(bps, sizeof(bps), "%.2f", mr.bytes_per_synapse());
+        IoLogger::instance().log_status("🧮 Speicherbilanz: " + human_bytes(mr.total().bytes) + " belegt, "
+                                        + human_bytes(mr.total().reserved) + " reserviert, " + bps
+                                        + " B/Synapse, Höchststand " + human_bytes(ps.peak));
+        IoLogger::instance().log_memory(mr.to_json());
+    }
 
     // kleine Pause, damit der Coach/Monitor bereit ist
         std::this_thread::sleep_for(std::chrono::milliseconds(1000));
@@ -138,15 +476,88 @@ int main(int argc, char** argv) {
         fcntl(STDIN_FILENO, F_SETFL, flags | O_NONBLOCK);
     }
 
-    // (optional) Phoneminventar: erste 8 Neuronen als Laute
-    std::vector<std::string> PH = {"a","b","c","d","e","f","g","h","i","j","k","l","m","n","o","p","q","r","s","t","u","v","w","x","y","z","ä","ö","ü",",","."," "};
+    // Befehls-Protokoll (für --replay) und periodische Checkpoints
+    const std::string out_dir = "./../../io/out/";
+    CommandLog cmd_log;
+    cmd_log.open(out_dir + "commands_applied.jsonl");
+    const long checkpoint_every = (checkpoint_every_ms > 0.0) ? period_ticks(checkpoint_every_ms) : 0;
+    std::vector<std::string> checkpoints;
+    if (checkpoint_every > 0) std::filesystem::create_directories(out_dir + "checkpoints");
+
+    // Langzeit-Telemetrie: pro Abtastung Hormone, Spikes pro Population und mittlere Schrittzeit
+    TelemetryWriter telemetry;
+    std::vector<std::string> tel_cols = { "dopamine", "serotonin", "cortisol", "adrenaline", "oxytocin",
+                                          "melatonin", "noradrenaline", "endorphin", "acetylcholine", "testosterone" };
+    std::vector<std::pair<int, int>> tel_ranges;    // Populationen, sonst das ganze Netz
+    for (const auto& p : net.pops) {
+        tel_cols.push_back("spikes:" + p.name);
+        tel_ranges.push_back({ p.begin, p.end });
+    }
+    if (tel_ranges.empty()) {
+        tel_cols.push_back("spikes");
+        tel_ranges.push_back({ 0, net.neu.N });
+    }
+    tel_cols.push_back("step_us");
+    const long telemetry_every = period_ticks(telemetry_every_ms);
+    if (!telemetry_path.empty()) {
+        try {
+            telemetry.open(telemetry_path, tel_cols);
+            IoLogger::instance().log_status("📼 Telemetrie -> " + telemetry_path + ", " + std::to_string(tel_cols.size())
+                                            + " Spalten alle " + std::to_string(telemetry_every) + " Ticks");
+        } catch (const std::exception& e) {
+            std::cerr << "❌ " << e.what() << "\n";
+            return 1;
+        }
+    }
 
-    // seconds -> steps (dt aus dem Netz)
-    if (seconds >= 0.0) {
-        steps = static_cast<long>(seconds / net.neu.dt);
+    // Beobachter laufen auf eigenem Thread über Snapshots (observer.h):
+    // der Takt zahlt pro Tick nur Spike-Liste + Zeigertausch, egal wie viele es sind
+    const int N = net.neu.N;
+    probe_ids.erase(std::remove_if(probe_ids.begin(), probe_ids.end(), [N](int i) { return i < 0 || i >= N; }),
+                    probe_ids.end());
+    ObserverHub observers;
+    observers.configure(probe_ids, tel_ranges);
+    observers.add("logger", [N](const Snapshot& s) {
+        std::vector<uint8_t> spk(N);
+        for (const auto& smp : s.samples) {
+            if (!(smp.marks & Snapshot::kLog)) continue;
+            std::fill(spk.begin(), spk.end(), 0);
+            for (int i : smp.spike_ids) spk[i] = 1;
+            IoLogger::instance().log_spike_matrix(spk, static_cast<int>(smp.step));
+            IoLogger::instance().log_spike(&smp.hormones, static_cast<int>(smp.step), smp.spike_count, &smp.probe_V);
+        }
+    });
+    observers.add("tokens", [](const Snapshot& s) {
+        for (const auto& tk : s.tokens)
+            IoLogger::instance().log_token(tk.tick, tk.text, tk.output, tk.neuron, tk.count);
+    });
+    if (telemetry.is_open()) {
+        // Zeile pro markiertem Tick; Spikes und Schrittzeit als Differenz der kumulativen Zähler
+        struct TelState { long step = 0; double us = 0.0; std::vector<uint64_t> spikes; };
+        auto st = std::make_shared<TelState>();
+        st->spikes.assign(tel_ranges.size(), 0);
+        observers.add("telemetry", [&telemetry, st, n_cols = tel_cols.size()](const Snapshot& s) {
+            std::vector<float> row(n_cols, 0.0f);
+            for (const auto& smp : s.samples) {
+                if (!(smp.marks & Snapshot::kTelemetry)) continue;
+                const HormoneSet& h = smp.hormones;
+                const float hs[] = { h.dopamine, h.serotonin, h.cortisol, h.adrenaline, h.oxytocin,
+                                     h.melatonin, h.noradrenaline, h.endorphin, h.acetylcholine, h.testosterone };
+                std::copy(std::begin(hs), std::end(hs), row.begin());
+                for (size_t p = 0; p < st->spikes.size(); ++p)
+                    row[10 + p] = static_cast<float>(smp.range_spikes[p] - st->spikes[p]);
+                row.back() = static_cast<float>((smp.step_us - st->us) / std::max(1L, smp.step + 1 - st->step));
+                const int64_t now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
+                telemetry.record(now_ms, smp.tick, row.data());
+                st->step   = smp.step + 1;
+                st->us     = smp.step_us;
+                st->spikes = smp.range_spikes;
+            }
+        });
     }
+    observers.start();
 
-    float total_spikes = 0.0f;
     long  t = 0;                                  // Sim-Schrittzähler
     bool  infinite = (steps < 0);
 
@@ -160,18 +571,42 @@ int main(int argc, char** argv) {
     // wie oft loggen (in Schritten)
     const long print_every_steps = std::max<long>(1, static_cast<long>((print_every_ms / 1000.0) / sim_dt));
 
-    auto do_one_step = [&](long step_idx){
-        process_commands(net);
-        net.step_once(0.0f);
-
-        int sp = std::accumulate(net.neu.spk.begin(), net.neu.spk.end(), 0);
-        total_spikes += sp;
-
-        if (step_idx % print_every_steps == 0) {
+    if (procs > 1) {
+        IoLogger::instance().log_status("🧩 " + std::to_string(procs) + " Prozesse, Austausch alle "
+                                        + std::to_string(cluster.interval) + " Ticks, Partition 0: "
+                                        + std::to_string(net.n_synapses()) + " Synapsen ("
+                                        + std::to_string(cluster.n_ghost_synapses) + " von fremden Neuronen)");
+        return run_partitioned(net, cluster, cmd_log, steps, realtime, print_every_steps);
+    }
 
-            IoLogger::instance().log_spike_matrix(net.neu.spk, step_idx);
-            IoLogger::instance().log_spike(&net.H, step_idx, sp);
+    auto do_one_step = [&](long step_idx){
+        // Checkpoint vor den Befehlen dieses Ticks (so setzt --replay wieder ein)
+        if (checkpoint_every > 0 && net.tick % checkpoint_every == 0) {
+            const std::string path = out_dir + "checkpoints/ckpt_" + std::to_string(net.tick) + ".bin";
+            try {
+                save_checkpoint(net, path);
+                checkpoints.push_back(path);
+                if (checkpoints.size() > 10) {           // nur die letzten 10 behalten
+                    std::remove(checkpoints.front().c_str());
+                    checkpoints.erase(checkpoints.begin());
+                }
+            } catch (const std::exception& e) {
+                IoLogger::instance().log_error(e.what());
+            }
         }
+
+        process_commands(net, cmd_log);
+        const auto step_t0 = telemetry.is_open() ? clock::now() : clock::time_point{};
+        net.step_once(0.0f);
+        const double step_us = telemetry.is_open()
+            ? std::chrono::duration<double, std::micro>(clock::now() - step_t0).count() : 0.0;
+
+        // Snapshot veröffentlichen; Logger, Tokens und Telemetrie laufen auf dem Beobachter-Thread
+        uint8_t marks = 0;
+        if (step_idx % print_every_steps == 0) marks |= Snapshot::kLog;
+        if (telemetry.is_open() && (step_idx + 1) % telemetry_every == 0) marks |= Snapshot::kTelemetry;
+        observers.publish(net, step_idx, step_us, marks);
+        net.readout.decoded.clear();
     };
 
     while (running && (infinite || t < steps)) {
@@ -194,6 +629,26 @@ int main(int argc, char** argv) {
         }
     }
 
+    observers.stop();
+    IoLogger::instance().log_status("👀 Beobachter: " + std::to_string(observers.published()) + " Snapshots, "
+                                    + std::to_string(observers.skipped()) + " übersprungen (Ereignisse nachgereicht)");
+    if (net.structural_on)
+        IoLogger::instance().log_status("🌱 Struktur: +" + std::to_string(net.n_grown) + " / -"
+                                        + std::to_string(net.n_pruned) + " Synapsen, "
+                                        + std::to_string(net.n_compactions) + " Kompaktierungen");
+    if (net.plasticity == Plasticity::Reward)
+        IoLogger::instance().log_status("🎯 Drei-Faktor: " + std::to_string(net.n_rewards) + " Rewards, "
+                                        + std::to_string(net.n_eligible()) + " offene Eligibility-Traces");
+    cmd_log.close(net.tick);
+    if (telemetry.is_open()) {
+        telemetry.close();
+        IoLogger::instance().log_status("📼 Telemetrie: " + std::to_string(telemetry.rows()) + " Zeilen, "
+                                        + std::to_string(telemetry.blocks()) + " Blöcke, Datei "
+                                        + std::to_string(telemetry.bytes() >> 10) + " KB");
+    }
+    std::ostringstream hash;
+    hash << std::hex << state_hash(net);
+    IoLogger::instance().log_status("🔏 Tick " + std::to_string(net.tick) + ", State-Hash " + hash.str());
     IoLogger::instance().log_status("Brain stopped");
     // Save hormones
 
@@ -0,0 +1,302 @@
+#include "memory_report.h"
+#include "net.h"
+#include "network_builder.h"
+#include <sys/resource.h>
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+#include <iomanip>
+
+std::string human_bytes(size_t b) {
+    const char* unit[] = { "B", "KB", "MB", "GB", "TB" };
+    double v = static_cast<double>(b);
+    int u = 0;
+    while (v >= 1024.0 && u < 4) { v /= 1024.0; ++u; }
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), u ? "%.1f %s" : "%.0f %s", v, unit[u]);
+    return buf;
+}
+
+MemUse MemoryReport::total() const {
+    MemUse t;
+    for (const auto& it : items) t += it.use;
+    return t;
+}
+
+nlohmann::json MemoryReport::to_json() const {
+    const MemUse t = total();
+    nlohmann::json j = {
+        {"predicted", predicted},
+        {"total_bytes", t.bytes}, {"reserved_bytes", t.reserved},
+        {"synapses", synapses}, {"procedural_synapses", procedural},
+        {"bytes_per_synapse", bytes_per_synapse()}
+    };
+    nlohmann::json st = nlohmann::json::object();
+    for (const auto& it : items) st[it.name] = { {"bytes", it.use.bytes}, {"reserved", it.use.reserved} };
+    j["structures"] = st;
+    nlohmann::json ps = nlohmann::json::array();
+    for (const auto& p : pops)
+        ps.push_back({ {"name", p.name}, {"neurons", p.neurons}, {"synapses", p.synapses},
+                       {"procedural", p.procedural}, {"bytes", p.bytes} });
+    j["populations"] = ps;
+    if (!predicted) {
+        j["allocator"] = { {"bytes", placement.bytes}, {"peak", placement.peak},
+                           {"mapped_regions", placement.mapped_regions} };
+        j["rss_peak"] = rss_peak;
+    }
+    return j;
+}
+
+std::string MemoryReport::table() const {
+    std::ostringstream o;
+    const MemUse t = total();
+    o << (predicted ? "🧮 Speicherbilanz (Vorhersage aus der Spec)\n" : "🧮 Speicherbilanz\n");
+    for (const auto& it : items) {
+        o << "  " << std::left << std::setw(22) << it.name << std::right << std::setw(12)
+          << human_bytes(it.use.bytes);
+        if (it.use.reserved != it.use.bytes) o << "  (reserviert " << human_bytes(it.use.reserved) << ")";
+        o << "\n";
+    }
+    o << "  " << std::left << std::setw(22) << "gesamt" << std::right << std::setw(12) << human_bytes(t.bytes)
+      << "  (reserviert " << human_bytes(t.reserved) << ")\n";
+    o << "  Synapsen: " << synapses << " gespeichert";
+    if (procedural) o << " + " << procedural << " prozedural";
+    o << ", " << std::fixed << std::setprecision(2) << bytes_per_synapse() << " B/Synapse\n";
+    for (const auto& p : pops)
+        o << "  Population " << p.name << ": " << p.neurons << " Neuronen, " << p.synapses << " Synapsen"
+          << (p.procedural ? " + " + std::to_string(p.procedural) + " prozedural" : std::string())
+          << ", " << human_bytes(p.bytes) << "\n";
+    if (predicted) o << "  (Delay-Queue und Eligibility-Traces wachsen mit der Aktivität, nicht enthalten)\n";
+    else o << "  Allokator-Höchststand " << human_bytes(placement.peak) << ", RSS-Höchststand "
+           << human_bytes(rss_peak) << "\n";
+    return o.str();
+}
+
+// ---------------------------------------------------------------- live
+
+namespace {
+
+size_t weight_bytes(WeightFormat f) {
+    switch (f) {
+        case WeightFormat::F16: return sizeof(uint16_t);
+        case WeightFormat::I8:  return sizeof(int8_t);
+        default:                return sizeof(float);
+    }
+}
+
+MemUse rows_of(const RowSpans& r) {
+    MemUse m = mem_of(r.start);
+    m += mem_of(r.len);
+    m += mem_of(r.cap);
+    m += mem_of(r.by_start);
+    m += mem_of(r.packed);
+    return m;
+}
+
+// belegt = lebende Synapsen, reserviert = Slots (Reserve + Müll) bzw. Kapazität
+void add_store(MemoryReport& rep, const std::string& name, const SynapseStore& s) {
+    const size_t wb = weight_bytes(s.fmt);
+    MemUse t = { s.size() * sizeof(uint32_t), s.target.capacity() * sizeof(uint32_t) };
+    MemUse w = { s.size() * wb, 0 };
+    switch (s.fmt) {
+        case WeightFormat::F16: w.reserved = s.w16.capacity() * wb; break;
+        case WeightFormat::I8:  w.reserved = s.w8.capacity() * wb; w += mem_of(s.block_scale); break;
+        default:                w.reserved = s.w32.capacity() * wb; break;
+    }
+    const MemUse r = rows_of(s.rows);
+    rep.items.push_back({ name + ".target", t });
+    rep.items.push_back({ name + ".weights", w });
+    rep.items.push_back({ name + ".rows", r });
+    rep.synapse_bytes += t.bytes + w.bytes + r.bytes;
+    if (s.has_post_index()) {
+        MemUse c = rows_of(s.cols);
+        c += mem_of(s.in_pre);
+        c += mem_of(s.in_syn);
+        c += mem_of(s.csc_pos);
+        rep.items.push_back({ name + ".csc", c });
+        rep.synapse_bytes += c.bytes;
+    }
+}
+
+} // namespace
+
+MemoryReport memory_report(const Net& net) {
+    MemoryReport rep;
+    const Neurons& n = net.neu;
+    const int N = n.N;
+
+    // 1️⃣ Neuronen: pro Neuron dichte Arrays
+    MemUse state = mem_of(n.V);
+    for (const auto* v : { &n.Vth, &n.Vrest, &n.Vreset, &n.ref_left, &n.Isyn }) state += mem_of(*v);
+    MemUse aux;
+    for (const auto& b : n.blocks) aux += mem_of(b.aux);
+    MemUse spk = mem_of(n.spk_bits);
+    spk += mem_of(n.spikes);
+    for (const auto& p : net.part_spikes) spk += mem_of(p);
+    MemUse flags = mem_of(net.is_input);
+    flags += mem_of(net.is_output);
+    MemUse traces = mem_of(net.pre_trace);
+    traces += mem_of(net.post_trace);
+    traces += mem_of(net.trace_tick);
+
+    rep.items.push_back({ "neurons.state", state });
+    if (aux.reserved) rep.items.push_back({ "neurons.aux", aux });
+    rep.items.push_back({ "neurons.spikes", spk });
+    rep.items.push_back({ "neurons.flags", flags });
+    rep.items.push_back({ "traces", traces });
+
+    // 2️⃣ Synapsen: beide Stores (prozedurale belegen nichts)
+    add_store(rep, "syn", net.syn);
+    add_store(rep, "syn_static", net.syn_static);
+    rep.synapses   = net.n_synapses();
+    rep.procedural = net.n_procedural;
+
+    // 3️⃣ Laufzeit-Strukturen
+    rep.items.push_back({ "delay_queue", net.dq.memory() });
+    MemUse el;
+    for (const auto& e : net.elig) el += e.memory();
+    if (net.plasticity == Plasticity::Reward) rep.items.push_back({ "eligibility", el });
+    if (net.engine == Engine::Event) rep.items.push_back({ "event_engine", net.ev.memory() });
+    rep.items.push_back({ "readout", net.readout.memory() });
+
+    // 4️⃣ Populationen: Anteil am Neuronen-Zustand + ausgehende Synapsen
+    const MemUse ev = net.engine == Engine::Event ? net.ev.memory() : MemUse{};
+    const double per_neuron = N ? static_cast<double>(state.bytes + spk.bytes + flags.bytes + traces.bytes
+                                                      + ev.bytes) / N : 0.0;
+    const size_t bp = sizeof(uint32_t) + weight_bytes(net.syn.fmt);
+    const size_t bs = sizeof(uint32_t) + weight_bytes(net.syn_static.fmt);
+    for (const auto& p : net.pops) {
+        MemoryReport::Pop q;
+        q.name = p.name;
+        q.neurons = p.size();
+        size_t sp = 0, ss = 0;
+        for (int i = p.begin; i < p.end && i < net.syn.rows.rows(); ++i) sp += net.syn.rows.len[i];
+        for (int i = p.begin; i < p.end && i < net.syn_static.rows.rows(); ++i) ss += net.syn_static.rows.len[i];
+        q.synapses = sp + ss;
+        for (const auto& pp : net.procedural)
+            if (pp.g.s0 == p.begin) q.procedural += pp.count;
+        size_t a = 0;
+        for (const auto& b : n.blocks)
+            if (b.begin >= p.begin && b.end <= p.end) a += b.aux.size() * sizeof(float);
+        q.bytes = static_cast<size_t>(per_neuron * q.neurons) + sp * bp + ss * bs + a;
+        rep.pops.push_back(q);
+    }
+
+    // 5️⃣ Höchststände: placed-Allokationen und der ganze Prozess
+    rep.placement = placement_stats();
+    struct rusage ru {};
+    if (getrusage(RUSAGE_SELF, &ru) == 0) rep.rss_peak = static_cast<size_t>(ru.ru_maxrss) * 1024;   // Linux: KB
+    return rep;
+}
+
+// ---------------------------------------------------------------- Vorhersage
+
+MemoryReport predict_memory(const NetSpec& spec, WeightFormat fmt, Engine engine, bool structural,
+                            int readout_window) {
+    MemoryReport rep;
+    rep.predicted = true;
+    const Net defaults;
+    const float slack = spec.params.value("row_slack", defaults.row_slack);
+    const size_t N = static_cast<size_t>(spec.total_neurons());
+
+    // 1️⃣ erwartete Synapsen pro Projektion (nach Quell-Population)
+    const size_t np = spec.populations.size();
+    std::vector<double> out_p(np, 0.0), out_s(np, 0.0), out_proc(np, 0.0);
+    for (const auto& pr : spec.projections) {
+        const double ns = spec.populations[pr.src].size, nd = spec.populations[pr.dst].size;
+        const double self = (pr.src == pr.dst && !pr.allow_self) ? 1.0 : 0.0;
+        double c = 0.0;
+        switch (pr.rule) {
+            case ConnRule::FixedIn:   c = nd * std::min<double>(pr.n, ns - self); break;
+            case ConnRule::FixedOut:  c = ns * std::min<double>(pr.n, nd - self); break;
+            case ConnRule::FixedProb: c = std::clamp(pr.p, 0.0f, 1.0f) * ns * (nd - self); break;
+            case ConnRule::AllToAll:  c = ns * (nd - self); break;
+            case ConnRule::OneToOne:  c = self ? 0.0 : std::min(ns, nd); break;
+        }
+        const float sign = spec.populations[pr.src].role == PopRole::Inhibitory ? -1.0f : 1.0f;
+        if (pr.procedural)              out_proc[pr.src] += c;
+        else if (learns(pr.plastic, sign)) out_p[pr.src] += c;
+        else                            out_s[pr.src] += c;
+    }
+    double sp = 0.0, ss = 0.0, sproc = 0.0;
+    for (size_t p = 0; p < np; ++p) { sp += out_p[p]; ss += out_s[p]; sproc += out_proc[p]; }
+
+    // 2️⃣ Neuronen (wie memory_report, Spike-Liste ohne Aktivität leer)
+    const bool event = engine == Engine::Event;
+    size_t aux = 0;
+    for (const auto& ps : spec.populations)
+        if (ps.model != NeuronModel::LIF) aux += ps.size * sizeof(float);
+    const size_t state = 6 * N * sizeof(float);
+    const size_t spk   = (N + 63) / 64 * sizeof(uint64_t);
+    const size_t flags = 2 * ((N + 7) / 8);
+    const size_t traces = 2 * N * sizeof(float) + (event ? N * sizeof(long) : 0);
+    rep.items.push_back({ "neurons.state", { state, state } });
+    if (aux) rep.items.push_back({ "neurons.aux", { aux, aux } });
+    rep.items.push_back({ "neurons.spikes", { spk, spk } });
+    rep.items.push_back({ "neurons.flags", { flags, flags } });
+    rep.items.push_back({ "traces", { traces, traces } });
+
+    // 3️⃣ Stores: target + Gewicht pro Synapse, 3 × uint32 pro Zeile (+ by_start mit Reserve);
+    //    strukturelle Plastizität reserviert pro plastischer Zeile max(2, len * row_slack)
+    const size_t wb = weight_bytes(fmt);
+    const auto extra = [&](double total) {
+        if (!structural || N == 0) return 0.0;
+        const double avg = total / N;
+        return N * std::max(2.0, std::ceil(avg * slack));
+    };
+    const auto store = [&](const std::string& name, double live, double slots, bool csc) {
+        const size_t n = static_cast<size_t>(std::llround(live)), cap = static_cast<size_t>(std::llround(slots));
+        MemUse w = { n * wb, cap * wb };
+        if (fmt == WeightFormat::I8) {
+            const size_t bs = ((cap >> SynapseStore::kBlockShift) + 1) * sizeof(float);
+            w.bytes += bs;
+            w.reserved += bs;
+        }
+        // mit Reserve (strukturelle Plastizität) dazu by_start pro Zeile
+        const size_t rows = N * (3 * sizeof(uint32_t) + (cap > n ? sizeof(RowSpans::Ref) : 0));
+        rep.items.push_back({ name + ".target", { n * sizeof(uint32_t), cap * sizeof(uint32_t) } });
+        rep.items.push_back({ name + ".weights", w });
+        rep.items.push_back({ name + ".rows", { rows, rows } });
+        rep.synapse_bytes += n * (sizeof(uint32_t) + wb) + rows;
+        if (csc) {
+            // Spalten + in_pre/in_syn pro Slot + csc_pos pro Store-Slot
+            const size_t ccap = static_cast<size_t>(std::llround(live + extra(live)));
+            const size_t c = rows + ccap * (sizeof(int) + sizeof(uint32_t)) + cap * sizeof(uint32_t);
+            rep.items.push_back({ name + ".csc", { c, c } });
+            rep.synapse_bytes += c;
+        }
+    };
+    store("syn", sp, sp + extra(sp), true);   // CSC für spike-getriebene STDP, beide Engines
+    store("syn_static", ss, ss, false);
+    rep.synapses   = static_cast<size_t>(std::llround(sp + ss));
+    rep.procedural = static_cast<size_t>(std::llround(sproc));
+
+    // 4️⃣ Laufzeit: Event-Engine pro Neuron, Readout-Index pro Neuron + Zähler pro Output + Fenster
+    size_t n_out = 0;
+    for (const auto& ps : spec.populations)
+        if (ps.role == PopRole::Output) n_out += ps.size;
+    if (event) {
+        const size_t e = N * (2 * sizeof(long) + sizeof(uint8_t));
+        rep.items.push_back({ "event_engine", { e, e } });
+    }
+    const size_t ro = N * sizeof(int) + n_out * (2 * sizeof(int) + sizeof(uint8_t))
+                    + static_cast<size_t>(std::max(1, readout_window)) * sizeof(std::vector<int>);
+    rep.items.push_back({ "readout", { ro, ro } });
+
+    // 5️⃣ Populationen
+    const double per_neuron = N ? static_cast<double>(state + spk + flags + traces
+                                                      + (event ? N * (2 * sizeof(long) + 1) : 0)) / N : 0.0;
+    const double bps = static_cast<double>(sizeof(uint32_t) + wb);
+    for (size_t p = 0; p < np; ++p) {
+        const auto& ps = spec.populations[p];
+        MemoryReport::Pop q;
+        q.name = ps.name;
+        q.neurons = ps.size;
+        q.synapses = static_cast<size_t>(std::llround(out_p[p] + out_s[p]));
+        q.procedural = static_cast<size_t>(std::llround(out_proc[p]));
+        q.bytes = static_cast<size_t>(per_neuron * ps.size + (out_p[p] + out_s[p]) * bps)
+                + (ps.model != NeuronModel::LIF ? ps.size * sizeof(float) : 0);
+        rep.pops.push_back(q);
+    }
+    return rep;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <nlohmann/json.hpp>
+#include "placement.h"
+#include "synapse_store.h"
+
+class Net;
+struct NetSpec;
+enum class Engine;
+
+// Speicherbilanz der großen Strukturen: pro Struktur belegt (size) und reserviert
+// (capacity), pro Population, Bytes pro Synapse, Allokator-Höchststand.
+// Live aus einem gebauten Netz (Befehl memory_report, Start-Log) oder als
+// Vorhersage aus der Netz-Spec ohne Aufbau (--dry-run).
+struct MemoryReport {
+    struct Item {
+        std::string name;
+        MemUse use;
+    };
+    struct Pop {
+        std::string name;
+        int    neurons = 0;
+        size_t synapses = 0;     // ausgehend, gespeichert
+        size_t procedural = 0;   // ausgehend, prozedural (kein Speicher)
+        size_t bytes = 0;        // Neuronen-Zustand + ausgehende Synapsen
+    };
+
+    std::vector<Item> items;
+    std::vector<Pop>  pops;
+    size_t synapses = 0, procedural = 0;
+    size_t synapse_bytes = 0;    // Stores: target, Gewichte, Zeilen, CSC
+    bool   predicted = false;    // Vorhersage: Delay-Queue und Eligibility hängen von der Aktivität ab
+    PlacementStats placement;    // nur live
+    size_t rss_peak = 0;         // nur live: Höchststand des Prozesses (getrusage)
+
+    MemUse total() const;
+    double bytes_per_synapse() const { return synapses ? static_cast<double>(synapse_bytes) / synapses : 0.0; }
+
+    nlohmann::json to_json() const;
+    std::string    table() const;   // Klartext für --dry-run
+};
+
+MemoryReport memory_report(const Net& net);
+
+// Erwartungswerte aus der Spec: fixed_prob mit p * Paare, die übrigen Regeln exakt
+MemoryReport predict_memory(const NetSpec& spec, WeightFormat fmt, Engine engine, bool structural,
+                            int readout_window);
+
+std::string human_bytes(size_t b);
@@ -4,8 +4,8 @@
 #include "io_logger.h"
 
 void Net::build_small_demo(int N, int fan_in, int n_inputs, int n_outputs) {
-    neu.init(N);
-    neu.input_neurons = &input_target;
+    init_neurons(N);
+    hop_attenuation = true;   // Gewichte unten sind auf die Tiefen-Dämpfung (delay 0..3) abgestimmt
 
     this->n_inputs = n_inputs;
     this->n_outputs = n_outputs;
@@ -36,9 +36,15 @@ void Net::build_small_demo(int N, int fan_in, int n_inputs, int n_outputs) {
     for (int i = 0; i < n_inputs; ++i)
     is_inhibitory[i] = false;
 
+    pops = {
+        { "input",  0,             n_inputs,      PopRole::Input },
+        { "hidden", n_inputs,      N - n_outputs, PopRole::Excitatory },
+        { "output", N - n_outputs, N,             PopRole::Output },
+    };
+
     std::mt19937 r2(123);
-    syn.clear();
-    syn.reserve(static_cast<size_t>(N) * fan_in);
+    std::vector<Synapse> edges;
+    edges.reserve(static_cast<size_t>(N) * fan_in);
 
     for (int post = 0; post < N; ++post) {
         for (int k = 0; k < fan_in; ++k) {
@@ -54,140 +60,424 @@ void Net::build_small_demo(int N, int fan_in, int n_inputs, int n_outputs) {
             // Inhibitorische Synapsen machen negative Gewichte
             if (is_inhibitory[pre])
                 w *= -2.0f; // stärkere Wirkung (z.B. -0.2 bis -0.6)
+            else
+                w = std::clamp(w, wmin, wmax); // STDP hält erregende Gewichte ohnehin in [wmin, wmax]
+
+            // Input-Neuronen feuern nur extern (Reize, Rauschen), keine Synapsen auf sie
+            if (is_input[post]) continue;
 
-            syn.push_back({ pre, post, w });
+            edges.push_back({ pre, post, w, 0 });
         }
     }
 
-    syn_by_pre.resize(syn.size());
-    std::iota(syn_by_pre.begin(), syn_by_pre.end(), 0);
+    for (auto& e : edges) {
+        e.delay = static_cast<uint16_t>(rng() % 4);
+    }
 
-    std::sort(syn_by_pre.begin(), syn_by_pre.end(), [&](int a, int b) {
-        if (syn[a].pre != syn[b].pre) return syn[a].pre < syn[b].pre;
-        return syn[a].post < syn[b].post;
-    });
+    // CSR direkt packen (ersetzt syn + syn_by_pre + pre_offsets)
+    pack_synapses(edges, std::max(std::fabs(wmin), std::fabs(wmax)));
+
+    init_runtime();
+}
 
-    pre_offsets.assign(N + 1, 0);
-    for (int idx : syn_by_pre) pre_offsets[syn[idx].pre + 1]++;
-    for (int i = 1; i <= N; ++i) pre_offsets[i] += pre_offsets[i - 1];
+void Net::pack_synapses(std::vector<Synapse>& edges, float w_abs_max) {
+    const auto mid = std::stable_partition(edges.begin(), edges.end(),
+                                           [](const Synapse& e) { return learns(e.plastic, e.w); });
+    std::vector<Synapse> fixed(mid, edges.end());
+    edges.erase(mid, edges.end());
+    for (auto& e : fixed) e.plastic = false;
 
-    ring_init(); 
+    syn.build(neu.N, edges, weight_format, w_abs_max, store_rows());
+    syn_static.build(neu.N, fixed, weight_format, w_abs_max, store_rows());
+}
 
-    pre_trace.assign(syn.size(), 0.0f);
-    post_trace.assign(syn.size(), 0.0f);
+void Net::init_neurons(int N) {
+    neu.resize(N);
+    set_owned(0, N);
+    for_partitions([&](int b, int e) { neu.init_range(b, e); });
+}
+
+void Net::set_owned(int begin, int end) {
+    own_begin = begin;
+    own_end = end;
+
+    // Innere Grenzen auf absolute Vielfache von 1024 runden (nicht relativ zu begin, das mit
+    // --procs mitten in einem Wort liegt): eine 4 KB-Seite float und jedes spk_bits-Wort
+    // gehört genau einem Worker
+    const int P = std::max(1, threads);
+    const int n = end - begin;
+    part_bounds.assign(P + 1, end);
+    const int chunk = ((n + P - 1) / P + 1023) / 1024 * 1024;
+    part_bounds[0] = begin;
+    for (int w = 1; w < P; ++w)
+        part_bounds[w] = std::min(end, (begin + std::min(n, w * chunk) + 1023) / 1024 * 1024);
+    if (P > 1 && workers.size() == 0) workers.start(P, pin_threads);
+}
 
-    for (auto& s : syn) {
-        s.delay = static_cast<uint16_t>(rng() % 4);
+void Net::for_partitions(const std::function<void(int, int)>& fn) {
+    for_each_partition([&](int, int b, int e) { fn(b, e); });
+}
+
+void Net::for_each_partition(const std::function<void(int, int, int)>& fn) {
+    if (workers.size() > 1) {
+        workers.run([&](int w) { fn(w, part_bounds[w], part_bounds[w + 1]); });
+    } else {
+        fn(0, own_begin, own_end);
     }
 }
 
-void Net::inject_inputs(float dt) {
+RowRunner Net::store_rows() {
+    return [this](const std::function<void(int, int)>& fn) {
+        // Partitionen decken nur mit allen eigenen Neuronen jede Zeile ab (nicht mit --procs)
+        if (own_begin == 0 && own_end == neu.N) for_partitions(fn);
+        else fn(0, neu.N);
+    };
+}
 
-    // Externe Inputs über commands.jsonl
-    if (external_input_active && !external_input_pattern.empty()) {
-        int count = std::min<int>(external_input_pattern.size(), neu.N);
-        for (int i = 0; i < count; ++i) {
-            if (external_input_pattern[i]) {
-                neu.Isyn[i] += 1.0f; // kleiner Stromstoß -> Spike möglich
-            }
-        }
-        external_input_active = false; // nur 1 Schritt aktiv
+void Net::step_neurons() {
+    part_spikes.resize(std::max<size_t>(1, part_bounds.size() - 1));
+    for_each_partition([&](int w, int b, int e) { neu.step_range(b, e, part_spikes[w]); });
+    neu.spikes.clear();
+    for (const auto& p : part_spikes) neu.spikes.insert(neu.spikes.end(), p.begin(), p.end());
+}
+
+void Net::init_runtime() {
+    const int N = neu.N;
+    tick = 0;
+    pre_trace.resize(N);
+    post_trace.resize(N);
+    for_partitions([&](int b, int e) {
+        std::fill(pre_trace.begin() + b,  pre_trace.begin() + e,  0.0f);
+        std::fill(post_trace.begin() + b, post_trace.begin() + e, 0.0f);
+    });
+
+    // Delay verschiebt nur die Ankunft; Dämpfung pro delay nur im alten Tiefen-Modell,
+    // einmal vorgerechnet statt powf pro Synapse und Spike
+    hop_gain.assign(SynapseStore::kMaxDelay + 1, hop_attenuation ? 0.0f : 1.0f);
+    if (hop_attenuation)
+        for (int d = 0; d <= std::min(max_propagation_depth, SynapseStore::kMaxDelay); ++d)
+            hop_gain[d] = powf(spike_decay_per_hop, d);
+    dq.init(SynapseStore::kMaxDelay);
+    readout.init(output_target, N);
+
+    elig.assign(std::max<size_t>(1, part_bounds.size() - 1), {});
+    elig_rate.period = std::max(1, static_cast<int>(std::lround(tau_elig / neu.dt)));
+
+    // Reserve-Slots pro Zeile, damit Wachstum meist ohne Umzug auskommt
+    if (structural_on) syn.compact(row_slack, store_rows());
+    // eingehende Synapsen pro Post: STDP beider Engines läuft spike-getrieben
+    syn.build_post_index(N, structural_on ? row_slack : 0.0f);
+
+    if (engine == Engine::Event) {
+        // geschlossener Zerfall zwischen Ereignissen gibt es nur für LIF
+        if (!neu.all_lif()) throw std::runtime_error("--engine event geht nur mit LIF-Populationen");
+        trace_tick.assign(N, 0);
+        ev.init(*this);
     }
+}
+
+bool Net::input_fires(float amp, int ticks) const {
+    if (input_target.empty()) return false;
+    // LIF ab Vrest mit konstantem Strom: V_k = Vrest + amp * (1 - P^k)
+    const int i = input_target.front();
+    const float gain = 1.0f - std::pow(neu.prop, static_cast<float>(std::max(1, ticks)));
+    return neu.Vrest[i] + amp * gain >= neu.threshold(i);
+}
+
+void Net::add_input(int i, float val) {
+    neu.Isyn[i] += val;
+    if (engine == Engine::Event) ev.touch(i);
+}
+
+void Net::inject_inputs(float dt) {
+
+    // Geplante Reize über commands.jsonl: nur die gerade aktiven Inputs
+    stimuli.apply(tick, [&](int idx, float amp) { add_input(input_target[idx], amp); });
 
     // Hintergrundrauschen NUR auf Input-Neuronen und schwächer:
-    const float noise_p   = 0.0002f;  // vorher 0.0005
+    const float noise_hz  = 0.2f;     // 0.0002 pro Tick bei dt = 1 ms
+    const float noise_p   = noise_hz * dt;
     const float noise_amp = 0.05f;    // vorher 0.2
-    for (int idx : input_target) {
-        if (uni(rng) < noise_p) neu.Isyn[idx] += noise_amp;
+    // geometrische Sprünge statt eines Münzwurfs pro Input (wie fixed_prob in for_each_target):
+    // Kosten ~ verrauschte Inputs + 1, nicht ~ Größe der Input-Schicht
+    if (noise_p <= 0.0f || input_target.empty()) return;
+    const double logq = std::log1p(-std::min(static_cast<double>(noise_p), 1.0 - 1e-9));
+    const long n = static_cast<long>(input_target.size());
+    for (long j = -1;;) {
+        const double u = 1.0 - uni(rng);   // (0, 1]
+        j += 1 + static_cast<long>(std::min(std::floor(std::log(u) / logq), 1e9));
+        if (j >= n) break;
+        add_input(input_target[j], noise_amp);
     }
 }
 
-void Net::route_spikes_no_delay() {
-    const auto& spk = neu.spk;
-    for (int pre = 0; pre < neu.N; ++pre) {
-        if (!spk[pre]) continue;
-        if (is_output[pre]) continue;
-        if (is_input[pre]) continue;  // Input nicht weiterleiten
+void Net::collect_delayed() {
+    dq.drain(tick, [&](int post, float val) { neu.Isyn[post] += val; });
+}
 
-        int begin = pre_offsets[pre], end = pre_offsets[pre + 1];
-        for (int p = begin; p < end; ++p) {
-            int sidx = syn_by_pre[p];
-            const auto& s = syn[sidx];
+void Net::route_spikes() {
+    for (int pre : neu.spikes) {
+        if (is_output[pre]) continue;
+        route_row(pre, tick, tick);
+    }
+}
 
-            // aktuelle "Tiefe" aus delay (0..R)
-            int depth = s.delay;
-            if (depth > max_propagation_depth) continue;
+void Net::route_row(int pre, long now, long s) {
+    auto push = [&](int post, int delay, float w) {
+        // hop_gain = 1, außer im alten Tiefen-Modell (0 -> keine Weiterleitung)
+        const float gain = hop_gain[delay];
+        if (gain == 0.0f) return;
+        dq.push(now, s + 1 + delay, post, w * gain);
+    };
+
+    // plastische Zeile, dann feste: pro post bleibt die Summationsreihenfolge über pre gleich
+    for (int k = syn.row_begin(pre); k < syn.row_end(pre); ++k) push(syn.post(k), syn.delay(k), syn.weight(k));
+
+    row_buf.clear();
+    const int gen = procedural.empty() ? 0 : procedural_row(pre, row_buf);
+    if (gen == 0) {
+        for (int k = syn_static.row_begin(pre); k < syn_static.row_end(pre); ++k)
+            push(syn_static.post(k), syn_static.delay(k), syn_static.weight(k));
+        return;
+    }
 
-            float decay = powf(spike_decay_per_hop, depth);
-            float val = s.w * decay;  // <--- dämpft exponentiell mit Tiefe
+    // prozedurale Ziele mit der gespeicherten festen Zeile so mischen, wie der Aufbau sortiert
+    // hätte (eine Projektion allein ist schon aufsteigend) -> gleiche Summen wie gespeichert
+    const int k0 = syn_static.row_begin(pre), k1 = syn_static.row_end(pre);
+    if (k1 > k0 || gen > 1) {
+        for (int k = k0; k < k1; ++k) row_buf.emplace_back(syn_static.target[k], syn_static.weight(k));
+        std::sort(row_buf.begin(), row_buf.end(), row_less);
+    }
+    for (const auto& [t, w] : row_buf) {
+        const int post = static_cast<int>(t & SynapseStore::kPostMask);
+        if (post < own_begin || post >= own_end) continue;   // --procs: fremde Ziele routet ihr Besitzer
+        push(post, static_cast<int>(t >> SynapseStore::kDelayShift), w);
+    }
+}
 
-            uint16_t dslot = static_cast<uint16_t>((rpos + s.delay) % R);
-            ring_enqueue(s.post, dslot, val);
-        }
+int Net::procedural_row(int pre, std::vector<std::pair<uint32_t, float>>& out) const {
+    thread_local std::vector<int> scratch;
+    const float dt_ms = neu.dt * 1000.0f;
+    int hit = 0;
+    for (const auto& pp : procedural) {
+        const int i = pre - pp.g.s0;
+        if (i < 0 || i >= pp.g.ns) continue;
+        ++hit;
+        // gleiche Ströme und Ziehreihenfolge wie emit() in build_from_spec
+        CounterRng rv(pp.seed, pp.proj, static_cast<uint64_t>(pre), kValues);
+        for_each_target(pp.seed, pp.proj, pp.pr, pp.g, i, scratch, [&](int j) {
+            const float w = syn_static.quantize(pp.sign * std::fabs(pp.pr.weight.sample(rv)));
+            const int   d = sample_delay_ticks(pp.pr.delay_ms, rv, dt_ms);
+            out.emplace_back(SynapseStore::pack_target(pp.g.d0 + j, d, false), w);
+        });
     }
+    return hit;
 }
 
 void Net::step_once(float external_reward) {
-    H.update(neu.dt);
-    neu.apply_hormones(H);
-    ring_collect_to_Isyn();
-    inject_inputs(neu.dt);
-    route_spikes_no_delay();
-    neu.step();
+    // Drei-Faktor: der Reward wirkt auf die bis zum letzten Tick gesammelten Traces
+    if (plasticity == Plasticity::Reward) {
+        const float R = external_reward + pending_reward;
+        if (R != 0.0f) apply_reward(R);
+        else if (elig_rate.due(tick)) prune_eligibility();
+    }
+    pending_reward = 0.0f;
 
-    stdp_decay_traces();
-    stdp_apply_updates();
+    if (hormone_rate.due(tick))    H.update(hormone_rate.span(neu.dt));
+    if (modulation_rate.due(tick)) neu.apply_hormones(H, modulation_rate.span(neu.dt));
+    if (!partitioned) readout.advance(tick);
 
-    rpos = static_cast<uint16_t>((rpos + 1) % R);
-}
+    if (engine == Engine::Event) {
+        ev.step(*this);
+    } else {
+        collect_delayed();
+        inject_inputs(neu.dt);
+        step_neurons();
 
-void Net::ring_init() {
-    ring.assign(static_cast<size_t>(neu.N) * R, 0.0f);
-    rpos = 0;
-}
+        stdp_decay_traces();
+        stdp_apply_updates();
 
-void Net::ring_collect_to_Isyn() {
-    const size_t N = static_cast<size_t>(neu.N);
-    const uint16_t slot = rpos;
-    for (size_t i = 0; i < N; ++i) {
-        float& cell = ring[i * R + slot];
-        neu.Isyn[i] += cell;
-        cell = 0.0f;
+        // nach STDP verteilen: die Spikes laufen mit den schon gelernten Gewichten los
+        route_spikes();
+    }
+
+    // nur die Output-Neuronen ansehen, nicht den ganzen Spike-Vektor
+    if (!partitioned) {
+        for (int i : neu.spikes)
+            if (is_output[i]) readout.on_spike(i, tick);
+        readout.decode(tick);
     }
-}
 
-inline void Net::ring_enqueue(int post, uint16_t dslot, float val) {
-    ring[static_cast<size_t>(post) * R + dslot] += val;
+    // Topologie nur zwischen zwei Ticks ändern (keine Zeile wird gerade gelesen)
+    if (structural_on && structural_rate.due(tick)) structural_step();
+    ++tick;
 }
 
 void Net::stdp_decay_traces() {
     const float dt = neu.dt;
     const float dp = std::exp(-dt / tau_pre);
     const float dq = std::exp(-dt / tau_post);
-    for (size_t i = 0; i < syn.size(); ++i) {
-        pre_trace[i]  *= dp;
-        post_trace[i] *= dq;
-    }
+    for_partitions([&](int b, int e) {
+        for (int i = b; i < e; ++i) {
+            pre_trace[i]  *= dp;
+            post_trace[i] *= dq;
+        }
+    });
 }
 
 void Net::stdp_apply_updates() {
-    const float mod = 1.0f + 0.5f * H.current.dopamine - 0.3f * H.current.cortisol;
+    const float mod = stdp_mod();
+    if (neu.spikes.empty()) return;   // ohne Spike ändert sich kein Gewicht
 
-    for (size_t si = 0; si < syn.size(); ++si) {
-        // Skip inhibitory synapses
-        if (syn[si].w < 0.0f) continue;
+    for (int i : neu.spikes) {
+        pre_trace[i]  += 1.0f;
+        post_trace[i] += 1.0f;
+    }
 
-        const auto& s = syn[si];
-        const bool pre_sp  = (s.pre  >=0 && s.pre  < neu.N) ? (neu.spk[s.pre]  != 0) : false;
-        const bool post_sp = (s.post >=0 && s.post < neu.N) ? (neu.spk[s.post] != 0) : false;
+    // Nur Synapsen gespikter Neuronen (wie stdp_on_spikes), nicht jede Zeile:
+    // Kosten ~ Spikes × Fan-in/-out. Nur der plastische Store, feste Synapsen kosten nichts
+    const float ed = std::exp(-neu.dt / tau_elig);
+    const bool reward = plasticity == Plasticity::Reward;
+    auto update = [&](EligibilityTraces* el, uint32_t k, int pre, int post, bool pre_sp, bool post_sp) {
+        if (el) {   // nur merken, das Gewicht ändert erst ein Reward
+            float de = 0.0f;
+            if (post_sp) de += Aplus  * pre_trace[pre];
+            if (pre_sp)  de -= Aminus * post_trace[post];
+            el->add(k, pre, post, de, tick, ed);
+            return;
+        }
+        float dw = 0.0f;
+        if (post_sp) dw += learning_rate * Aplus  * pre_trace[pre]  * mod;
+        if (pre_sp)  dw -= learning_rate * Aminus * post_trace[post] * mod;
+        syn.set_weight(k, std::clamp(syn.weight(k) + dw, wmin, wmax));
+    };
+    // neu.spikes ist aufsteigend: jede Partition nimmt ihren Ausschnitt
+    auto spikes_in = [&](int b, int e) {
+        return std::make_pair(std::lower_bound(neu.spikes.begin(), neu.spikes.end(), b),
+                              std::lower_bound(neu.spikes.begin(), neu.spikes.end(), e));
+    };
+
+    // 1️⃣ Pre hat gespikt: ausgehende Zeile (inkl. "beide gespikt"), nach Pre-Partition
+    for_partitions([&](int b, int e) {
+        EligibilityTraces* el = reward ? &elig[partition_of(b)] : nullptr;
+        const auto [first, last] = spikes_in(b, e);
+        for (auto it = first; it != last; ++it) {
+            const int pre = *it;
+            for (int k = syn.row_begin(pre); k < syn.row_end(pre); ++k)
+                update(el, static_cast<uint32_t>(k), pre, syn.post(k), true, neu.spiked(syn.post(k)));
+        }
+    });
 
-        if (pre_sp)  pre_trace[si]  += 1.0f;
-        if (post_sp) post_trace[si] += 1.0f;
+    // 2️⃣ Nur Post hat gespikt: eingehende Synapsen über den CSC-Index. Fremde Pre-Zeilen
+    //    (--procs) holt Cluster::replay_ghost_rows nach
+    auto incoming = [&](int post) {
+        for (int c = syn.col_begin(post); c < syn.col_end(post); ++c) {
+            const int pre = syn.in_pre[c];
+            if (neu.spiked(pre) || pre < own_begin || pre >= own_end) continue;
+            update(reward ? &elig[partition_of(pre)] : nullptr, syn.in_syn[c], pre, post, false, true);
+        }
+    };
+    if (reward) {
+        // Eligibility liegt pro Pre-Partition: seriell, sonst schrieben Worker in fremde Shards
+        for (int post : neu.spikes) incoming(post);
+    } else {
+        // jede Synapse hat genau einen Post: die Post-Partitionen schreiben disjunkte Slots
+        for_partitions([&](int b, int e) {
+            const auto [first, last] = spikes_in(b, e);
+            for (auto it = first; it != last; ++it) incoming(*it);
+        });
+    }
+}
 
-        float dw = 0.0f;
-        if (post_sp) dw += learning_rate * Aplus  * pre_trace[si]  * mod; 
-        if (pre_sp)  dw -= learning_rate * Aminus * post_trace[si] * mod; 
+void Net::stdp_on_spikes(const std::vector<int>& spikes) {
+    if (spikes.empty()) return;
+
+    const float mod = stdp_mod();
+    const float dp  = std::exp(-neu.dt / tau_pre);
+    const float dq  = std::exp(-neu.dt / tau_post);
+    const float ed  = std::exp(-neu.dt / tau_elig);
+    EligibilityTraces* el = (plasticity == Plasticity::Reward) ? &elig[0] : nullptr;
+
+    // Trace von Neuron i lazy auf den aktuellen Tick bringen
+    auto sync = [&](int i) {
+        const long k = tick - trace_tick[i];
+        if (k > 0) {
+            pre_trace[i]  *= std::pow(dp, static_cast<float>(k));
+            post_trace[i] *= std::pow(dq, static_cast<float>(k));
+            trace_tick[i] = tick;
+        }
+    };
 
-        syn[si].w = std::clamp(syn[si].w + dw, wmin, wmax);
+    for (int i : spikes) {
+        sync(i);
+        pre_trace[i]  += 1.0f;
+        post_trace[i] += 1.0f;
     }
+
+    // Pre hat gespikt: ausgehende Zeile (inkl. Fall "beide gespikt")
+    for (int pre : spikes) {
+        for (int k = syn.row_begin(pre); k < syn.row_end(pre); ++k) {
+            const float w = syn.weight(k);
+            const int post = syn.post(k);
+            sync(post);
+
+            if (el) {
+                float de = 0.0f;
+                if (neu.spiked(post)) de += Aplus * pre_trace[pre];
+                de -= Aminus * post_trace[post];
+                el->add(k, pre, post, de, tick, ed);
+                continue;
+            }
+
+            float dw = 0.0f;
+            if (neu.spiked(post)) dw += learning_rate * Aplus  * pre_trace[pre]  * mod;
+            dw -= learning_rate * Aminus * post_trace[post] * mod;
+
+            syn.set_weight(k, std::clamp(w + dw, wmin, wmax));
+        }
+    }
+
+    // Nur Post hat gespikt: eingehende Synapsen über den CSC-Index
+    for (int post : spikes) {
+        for (int e = syn.col_begin(post); e < syn.col_end(post); ++e) {
+            const int pre = syn.in_pre[e];
+            if (neu.spiked(pre)) continue;  // schon oben behandelt
+
+            const uint32_t k = syn.in_syn[e];
+            const float w = syn.weight(k);
+            sync(pre);
+            if (el) {
+                el->add(k, pre, post, Aplus * pre_trace[pre], tick, ed);
+                continue;
+            }
+            const float dw = learning_rate * Aplus * pre_trace[pre] * mod;
+            syn.set_weight(k, std::clamp(w + dw, wmin, wmax));
+        }
+    }
+}
+
+int Net::partition_of(int i) const {
+    const int p = static_cast<int>(std::upper_bound(part_bounds.begin(), part_bounds.end(), i) - part_bounds.begin()) - 1;
+    return std::clamp(p, 0, static_cast<int>(elig.size()) - 1);
+}
+
+void Net::apply_reward(float R) {
+    const float ed = std::exp(-neu.dt / tau_elig);
+    const float g  = reward_lr * R;
+    for (auto& el : elig)
+        el.visit(tick, ed, elig_eps, [&](const EligibilityTraces::Entry& x) {
+            syn.set_weight(x.k, std::clamp(syn.weight(x.k) + g * x.e, wmin, wmax));
+        });
+    ++n_rewards;
+}
+
+void Net::prune_eligibility() {
+    const float ed = std::exp(-neu.dt / tau_elig);
+    for (auto& el : elig) el.visit(tick, ed, elig_eps, [](const EligibilityTraces::Entry&) {});
+}
+
+size_t Net::n_eligible() const {
+    size_t n = 0;
+    for (const auto& el : elig) n += el.size();
+    return n;
 }
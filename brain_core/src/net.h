@@ -4,29 +4,117 @@
 #include <numeric>
 #include <algorithm>
 #include <cstdint>
+#include <string>
 #include "neurons.h"
 #include "hormones.h"
+#include "synapse_store.h"
+#include "event_engine.h"
+#include "delay_queue.h"
+#include "readout.h"
+#include "placement.h"
+#include "worker_pool.h"
+#include "stimulus.h"
+#include "eligibility.h"
+#include "connectivity.h"
+
+// Simulations-Engine, wird beim Start gewählt
+enum class Engine {
+    Clock,  // jeder Tick rechnet alle Neuronen / Synapsen
+    Event   // nur Neuronen mit Input, Kosten ~ Anzahl Ereignisse
+};
+
+// Lernregel der plastischen Synapsen
+enum class Plasticity {
+    STDP,    // Paar-STDP wirkt sofort aufs Gewicht, Hormone skalieren über stdp_mod()
+    Reward   // Drei-Faktor: STDP lädt Eligibility-Traces, erst ein Reward ändert Gewichte
+};
+
+// Rolle einer Population
+enum class PopRole { Input, Excitatory, Inhibitory, Output };
+
+// zusammenhängender ID-Bereich [begin, end)
+struct Population {
+    std::string name;
+    int begin = 0, end = 0;
+    PopRole role = PopRole::Excitatory;
+    NeuronModel model = NeuronModel::LIF;
+    int size() const { return end - begin; }
+};
+
+struct NetSpec;
 
-// einfache Synapse (ohne Delay)
-struct Synapse {
-    int   pre;
-    int   post;
-    float w;
-    uint16_t delay; // in "Ticks" (dt-Schritten)
+// Multi-Rate: ein langsamer Prozess läuft nur alle `period` Ticks und
+// integriert dann die ganze Periode in geschlossener Form
+struct Rate {
+    int period = 1;
+    bool  due(long tick) const  { return tick % period == 0; }
+    float span(float dt) const  { return period * dt; }
 };
 
 class Net {
 public:
     Neurons neu;
-    std::vector<Synapse> syn;
-
-    // Ganz oben in der Klasse Net:
-    std::vector<uint8_t> external_input_pattern; // temporäres Muster (0/1)
-    bool external_input_active = false;
-
-    // PRE-gruppierte Adjazenz (CSR-ähnlich)
-    std::vector<int> pre_offsets; 
-    std::vector<int> syn_by_pre;  
+    // Lernregel-Klasse wird beim Aufbau festgelegt, die Kernel fragen nie pro Synapse:
+    //  syn        = plastisch (erregend, plastic) -> STDP, CSC-Index, strukturelle Plastizität
+    //  syn_static = fest (inhibitorisch oder plastic = false) -> nur Weiterleitung
+    SynapseStore syn;                                 // CSR nach pre, kompakt
+    SynapseStore syn_static;
+
+    // Prozedurale Projektionen ("procedural": true, nur feste): kein Speicher pro Synapse.
+    // route_row erzeugt Ziele, Gewichte und Delays eines Pre-Neurons bei jedem Spike aus
+    // denselben CounterRng-Strömen wie der Aufbau (connectivity.h)
+    struct ProceduralProjection {
+        uint64_t seed;
+        int proj;                  // Index in NetSpec::projections (Teil des Stroms)
+        ProjectionSpec pr;
+        ProjRange g;
+        float sign;                // -1 für inhibitorische Quellen
+        size_t count = 0;          // Synapsen dieser Projektion
+    };
+    std::vector<ProceduralProjection> procedural;
+    size_t n_procedural = 0;       // so nie gespeicherte Synapsen
+
+    // prozedurale Ziele von pre an out anhängen (target gepackt, plastic = 0, je Projektion
+    // aufsteigend); Rückgabe: Anzahl Projektionen mit pre als Quelle
+    int procedural_row(int pre, std::vector<std::pair<uint32_t, float>>& out) const;
+    WeightFormat weight_format = WeightFormat::F32;   // vor build_* setzen
+    Engine engine = Engine::Clock;                    // vor build_* setzen
+    EventEngine ev;
+    long tick = 0;
+
+    std::vector<Population> pops;
+
+    // --- Partitionen / Worker (Takt-Modus) ---
+    // Worker w besitzt Neuronen [part_bounds[w], part_bounds[w+1]): schreibt sie zuerst
+    // (First Touch -> lokaler NUMA-Knoten) und rechnet sie in jedem Tick.
+    int  threads = 1;                 // vor build_* setzen
+    bool pin_threads = true;
+    WorkerPool workers;
+    std::vector<int> part_bounds;
+
+    // eigene Neuronen dieses Prozesses; nur mit --procs kleiner als [0, N) (cluster.cpp)
+    int  own_begin = 0, own_end = 0;
+    bool partitioned = false;         // Readout übernimmt dann Cluster (Rank 0)
+
+    void init_neurons(int N);                               // Speicher + partitionierter First Touch
+    void set_owned(int begin, int end);                     // Worker-Partitionen über [begin, end)
+    void for_partitions(const std::function<void(int, int)>& fn);
+    void for_each_partition(const std::function<void(int, int, int)>& fn);   // (w, begin, end)
+    RowRunner store_rows();   // Store-Zeilen (= Pre-Neuronen) partitionsweise füllen, s. SynapseStore
+
+    // Neuronen-Update der Partitionen; jede schreibt ihre eigene Spike-Liste, danach in
+    // Partitions-Reihenfolge aneinander -> neu.spikes aufsteigend, Kosten ~ Spikes
+    std::vector<std::vector<int>> part_spikes;
+    void step_neurons();
+
+    PopRole role_of(int i) const {
+        for (const auto& p : pops)
+            if (i >= p.begin && i < p.end) return p.role;
+        return PopRole::Excitatory;
+    }
+
+    // Geplante Reize auf der Input-Schicht (Befehle stimulus / input_pattern / input_sequence)
+    StimulusScheduler stimuli;
 
     // Externe Inputs
     int n_inputs = 3;
@@ -34,6 +122,7 @@ public:
     int n_outputs = 0;
     std::vector<int> output_target; // IDs der Output-Neuronen
     std::vector<bool> is_output;
+    Readout readout;                // Output-Spikes -> Tokens (vor build_* konfigurieren)
 
     std::vector<float> input_rate_hz;
     std::vector<int>   input_target;
@@ -45,17 +134,25 @@ public:
     HormoneSystem H;
     float learning_rate = 0.005f; 
 
-    // --- Delay-Ringpuffer ---
-    uint16_t R = 16;   
-    uint16_t rpos = 0; 
-    std::vector<float> ring; 
+    // Perioden der langsamen Prozesse (in Ticks)
+    Rate hormone_rate;     // HormoneSystem::update
+    Rate modulation_rate;  // Neurons::apply_hormones
+
+    // --- Verzögerte Zustellung ---
+    // Speicher ~ Spikes im Flug (statt N × R Ringpuffer). Ankunft: Tick t + 1 + delay
+    DelayQueue dq;
+    std::vector<float> hop_gain;   // Faktor pro delay: 1, nur mit hop_attenuation gedämpft (0 = jenseits max_propagation_depth)
 
-    void ring_init();                 
-    void ring_collect_to_Isyn();      
-    void ring_enqueue(int post, uint16_t dslot, float val); 
+    void collect_delayed();        // fällige Events -> Isyn
+    void route_spikes();           // Spikes dieses Ticks in die Queue
+    void route_row(int pre, long now, long s);   // Spike von pre in Tick s, Ankunft s + 1 + delay
+    std::vector<std::pair<uint32_t, float>> row_buf;   // feste + prozedurale Zeile in route_row
 
-    std::vector<float> pre_trace;   
-    std::vector<float> post_trace;  
+    // STDP-Traces pro Neuron (nicht pro Synapse): alle Synapsen eines
+    // Pre-Neurons sehen denselben pre-Trace, alle eines Post-Neurons denselben post-Trace
+    pvector<float> pre_trace;   
+    pvector<float> post_trace;  
+    std::vector<long>  trace_tick;  // nur Event-Modus: Traces gelten für diesen Tick (lazy Zerfall)
 
     // STDP-Parameter
     float tau_pre  = 0.020f;    
@@ -65,15 +162,63 @@ public:
     float wmin     = 0.0f;
     float wmax     = 0.2f;
 
+    // Altes Tiefen-Modell: delay zählt als "Hop", jede Zustellung wird mit spike_decay_per_hop^delay
+    // gedämpft und ab max_propagation_depth verworfen. Nur das Demo-Netz ist darauf abgestimmt;
+    // Spec-Netze haben reine axonale Delays (Faktor 1), außer params.hop_attenuation = true.
+    bool  hop_attenuation = false;
     float spike_decay_per_hop = 0.1f;  // 30% Signal bleibt übrig
     int max_propagation_depth = 5;     // danach keine Weiterleitung mehr
 
+    // --- Strukturelle Plastizität (Pruning + Wachstum), structural_plasticity.cpp ---
+    bool  structural_on   = false;
+    Rate  structural_rate;          // Periode in Ticks
+    float prune_eps       = 1e-4f;  // Gewicht <= wmin + eps gilt als abgestorben
+    int   prune_rows      = 64;     // Pre-Zeilen pro Schritt (rotierend, begrenzt die Kosten)
+    int   grow_max        = 8;      // neue Synapsen pro Schritt
+    float grow_w          = 0.05f;  // Startgewicht neuer Synapsen
+    int   grow_delay      = 1;      // delay neuer Synapsen (Ticks)
+    float coactive_trace  = 0.5f;   // post_trace ab hier gilt ein Neuron als "gerade aktiv"
+    float row_slack       = 0.25f;  // Reserve pro Zeile beim (Neu-)Anlegen
+    int   compact_slots   = 65536;  // Slots, die das Aufräumen pro Schritt höchstens umzieht
+    int   prune_cursor    = 0;
+    long  n_pruned = 0, n_grown = 0, n_compactions = 0;
+
+    void structural_step();
+
+    // --- Drei-Faktor-Lernen (--plasticity reward) ---
+    // Reward kommt über den Befehl "reward" (pending_reward) oder step_once(external_reward)
+    // und wirkt zu Beginn des nächsten Ticks: dw = reward_lr * R * e
+    Plasticity plasticity = Plasticity::STDP;
+    float tau_elig       = 1.0f;     // Zerfall der Eligibility in s
+    float reward_lr      = 1.0f;
+    float elig_eps       = 1e-6f;    // kleinere Traces werden verworfen
+    float pending_reward = 0.0f;
+    Rate  elig_rate;                 // Aufräumen zerfallener Einträge, Periode = tau_elig
+    std::vector<EligibilityTraces> elig;   // ein Shard pro Worker-Partition (nach pre)
+    long  n_rewards = 0;
+
+    void   apply_reward(float R);
+    void   prune_eligibility();
+    size_t n_eligible() const;
+    int    partition_of(int i) const;       // Partition (= Eligibility-Shard), die Neuron i enthält
+
     void stdp_decay_traces();          
+    float stdp_mod() const { return 1.0f + 0.5f * H.current.dopamine - 0.3f * H.current.cortisol; }
     void stdp_apply_updates();    
+    void stdp_on_spikes(const std::vector<int>& spikes);  // spike-getrieben, lazy Traces
+
+    // edges auf syn / syn_static verteilen und packen (Reihenfolge je Klasse bleibt)
+    void pack_synapses(std::vector<Synapse>& edges, float w_abs_max);
+    size_t n_synapses() const { return syn.size() + syn_static.size(); }
+
+    void init_runtime();  // nach dem Aufbau: Delay-Queue, Traces, Engine
 
 public:
     void build_small_demo(int N, int fan_in, int n_inputs, int n_outputs);
+    void build_from_spec(const NetSpec& spec);   // network_builder.cpp
+    void add_input(int i, float val);
+    // feuert ein ruhendes Input-Neuron, wenn es `ticks` Ticks lang amp pro Tick bekommt?
+    bool input_fires(float amp, int ticks) const;
     void inject_inputs(float dt);
-    void route_spikes_no_delay();
     void step_once(float external_reward);
 };
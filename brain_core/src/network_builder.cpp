@@ -0,0 +1,381 @@
+#include "network_builder.h"
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <functional>
+#include <stdexcept>
+#include <cmath>
+#include <limits>
+
+using json = nlohmann::json;
+
+// -------------------------------------------------------------
+// Spec einlesen
+// -------------------------------------------------------------
+static PopRole parse_role(const std::string& s) {
+    if (s == "input")      return PopRole::Input;
+    if (s == "excitatory") return PopRole::Excitatory;
+    if (s == "inhibitory") return PopRole::Inhibitory;
+    if (s == "output")     return PopRole::Output;
+    throw std::runtime_error("Unbekannte Rolle: " + s);
+}
+
+static ConnRule parse_rule(const std::string& s) {
+    if (s == "fixed_in")   return ConnRule::FixedIn;
+    if (s == "fixed_out")  return ConnRule::FixedOut;
+    if (s == "fixed_prob") return ConnRule::FixedProb;
+    if (s == "all_to_all") return ConnRule::AllToAll;
+    if (s == "one_to_one") return ConnRule::OneToOne;
+    throw std::runtime_error("Unbekannte Verbindungsregel: " + s);
+}
+
+// Zahl -> Const, sonst {"dist":"uniform","min":..,"max":..} / {"dist":"normal","mean":..,"std":..}
+static Distribution parse_dist(const json& j) {
+    Distribution d;
+    if (j.is_number()) {
+        d.a = j.get<float>();
+        return d;
+    }
+    const std::string kind = j.value("dist", "const");
+    if (kind == "const") {
+        d.a = j.value("value", 0.0f);
+    } else if (kind == "uniform") {
+        d.kind = Distribution::Uniform;
+        d.a = j.value("min", 0.0f);
+        d.b = j.value("max", d.a);
+    } else if (kind == "normal") {
+        d.kind = Distribution::Normal;
+        d.a = j.value("mean", 0.0f);
+        d.b = j.value("std", 0.0f);
+    } else {
+        throw std::runtime_error("Unbekannte Verteilung: " + kind);
+    }
+    return d;
+}
+
+int NetSpec::total_neurons() const {
+    int n = 0;
+    for (const auto& p : populations) n += p.size;
+    return n;
+}
+
+NetSpec parse_net_spec(const json& j) {
+    NetSpec spec;
+    spec.seed    = j.value("seed", spec.seed);
+    spec.threads = j.value("threads", 0);
+    if (j.contains("params")) spec.params = j["params"];
+
+    auto pop_index = [&](const std::string& name) {
+        for (size_t i = 0; i < spec.populations.size(); ++i)
+            if (spec.populations[i].name == name) return static_cast<int>(i);
+        throw std::runtime_error("Unbekannte Population: " + name);
+    };
+
+    for (const auto& p : j.at("populations")) {
+        PopulationSpec ps;
+        ps.name = p.at("name").get<std::string>();
+        ps.size = p.at("size").get<int>();
+        ps.role = parse_role(p.value("role", "excitatory"));
+        ps.model = parse_neuron_model(p.value("model", "lif"));
+        if (ps.role == PopRole::Input && ps.model != NeuronModel::LIF)
+            throw std::runtime_error("Input-Population " + ps.name + " feuert nur extern, model muss lif sein");
+        if (ps.size <= 0) throw std::runtime_error("Population ohne Neuronen: " + ps.name);
+        spec.populations.push_back(ps);
+    }
+
+    for (const auto& p : j.value("projections", json::array())) {
+        ProjectionSpec pr;
+        pr.src        = pop_index(p.at("from").get<std::string>());
+        pr.dst        = pop_index(p.at("to").get<std::string>());
+        pr.rule       = parse_rule(p.value("rule", "fixed_prob"));
+        pr.n          = p.value("n", 0);
+        pr.p          = p.value("p", 0.0f);
+        pr.weight     = parse_dist(p.value("weight", json(0.1f)));
+        pr.delay_ms   = parse_dist(p.value("delay_ms", json(1.0f)));
+        pr.plastic    = p.value("plastic", true);
+        pr.allow_self = p.value("allow_self", false);
+        pr.procedural = p.value("procedural", false);
+        if (pr.procedural && pr.rule == ConnRule::FixedIn)
+            throw std::runtime_error("procedural braucht eine pre-zentrierte Regel (nicht fixed_in)");
+        if (pr.procedural && pr.plastic && spec.populations[pr.src].role != PopRole::Inhibitory)
+            throw std::runtime_error("procedural nur für feste Projektionen (plastic: false oder inhibitorische Quelle)");
+        if (spec.populations[pr.dst].role == PopRole::Input)
+            throw std::runtime_error("Projektion auf Input-Population " + spec.populations[pr.dst].name
+                                     + ": Input feuert nur extern");
+        if (pr.rule == ConnRule::OneToOne &&
+            spec.populations[pr.src].size != spec.populations[pr.dst].size)
+            throw std::runtime_error("one_to_one braucht gleich große Populationen");
+        spec.projections.push_back(pr);
+    }
+
+    if (spec.total_neurons() > static_cast<int>(SynapseStore::kPostMask))
+        throw std::runtime_error("Zu viele Neuronen für 24-Bit-IDs");
+    return spec;
+}
+
+NetSpec load_net_spec(const std::string& path) {
+    std::ifstream f(path);
+    if (!f.is_open()) throw std::runtime_error("Netz-Spec nicht lesbar: " + path);
+    return parse_net_spec(json::parse(f));
+}
+
+namespace {
+
+void parallel_for(int threads, int n, const std::function<void(int, int)>& fn) {
+    if (threads <= 1 || n < 256) {
+        fn(0, n);
+        return;
+    }
+    const int chunk = (n + threads - 1) / threads;
+    std::vector<std::thread> pool;
+    for (int b = 0; b < n; b += chunk)
+        pool.emplace_back(fn, b, std::min(n, b + chunk));
+    for (auto& t : pool) t.join();
+}
+
+} // namespace
+
+// -------------------------------------------------------------
+// Aufbau: CSR direkt, zwei Pässe (zählen, füllen), paralleler Prefix-Sum,
+// danach nur lokale Sorts pro Zeile – kein globaler Sort
+// -------------------------------------------------------------
+void Net::build_from_spec(const NetSpec& spec) {
+    const int N = spec.total_neurons();
+    init_neurons(N);
+
+    // Parameter-Overrides
+    const json& P = spec.params;
+    learning_rate         = P.value("learning_rate", learning_rate);
+    tau_pre               = P.value("tau_pre", tau_pre);
+    tau_post              = P.value("tau_post", tau_post);
+    Aplus                 = P.value("Aplus", Aplus);
+    Aminus                = P.value("Aminus", Aminus);
+    wmin                  = P.value("wmin", wmin);
+    wmax                  = P.value("wmax", wmax);
+    spike_decay_per_hop   = P.value("spike_decay_per_hop", spike_decay_per_hop);
+    max_propagation_depth = P.value("max_propagation_depth", max_propagation_depth);
+    hop_attenuation       = P.value("hop_attenuation", hop_attenuation);
+    prune_eps             = P.value("prune_eps", prune_eps);
+    grow_max              = P.value("grow_max", grow_max);
+    grow_w                = P.value("grow_w", grow_w);
+    row_slack             = P.value("row_slack", row_slack);
+    compact_slots         = P.value("compact_slots", compact_slots);
+
+    // 1️⃣ Populationen -> ID-Bereiche
+    pops.clear();
+    input_target.clear();
+    output_target.clear();
+    int next = 0;
+    for (const auto& ps : spec.populations) {
+        pops.push_back({ ps.name, next, next + ps.size, ps.role, ps.model });
+        if (ps.model != NeuronModel::LIF) neu.set_model(next, next + ps.size, ps.model);
+        for (int i = next; i < next + ps.size; ++i) {
+            if (ps.role == PopRole::Input)  input_target.push_back(i);
+            if (ps.role == PopRole::Output) output_target.push_back(i);
+        }
+        next += ps.size;
+    }
+    n_inputs  = static_cast<int>(input_target.size());
+    n_outputs = static_cast<int>(output_target.size());
+    is_input.assign(N, false);
+    is_output.assign(N, false);
+    for (int i : input_target)  is_input[i] = true;
+    for (int i : output_target) is_output[i] = true;
+
+    const int T = spec.threads > 0 ? spec.threads
+                                   : std::max(1u, std::thread::hardware_concurrency());
+    const float dt_ms = neu.dt * 1000.0f;
+
+    std::vector<ProjRange> ranges;
+    for (const auto& pr : spec.projections) {
+        const auto& a = pops[pr.src];
+        const auto& b = pops[pr.dst];
+        // im Tiefen-Modell kommt jenseits max_propagation_depth nichts mehr an
+        if (hop_attenuation && std::lround(pr.delay_ms.abs_bound() / dt_ms) > max_propagation_depth)
+            throw std::runtime_error("Projektion " + a.name + " -> " + b.name + ": delay_ms bis "
+                                     + std::to_string(pr.delay_ms.abs_bound()) + " liegt mit hop_attenuation jenseits "
+                                     "max_propagation_depth = " + std::to_string(max_propagation_depth) + " Ticks");
+        ranges.push_back({ a.begin, a.size(), b.begin, b.size(), pr.src == pr.dst && !pr.allow_self });
+    }
+
+    // prozedurale Projektionen: nur die Regel merken, route_row erzeugt die Zeilen beim Spike
+    procedural.clear();
+    for (size_t p = 0; p < spec.projections.size(); ++p) {
+        const auto& pr = spec.projections[p];
+        if (!pr.procedural) continue;
+        const float sign = (pops[pr.src].role == PopRole::Inhibitory) ? -1.0f : 1.0f;
+        procedural.push_back({ spec.seed, static_cast<int>(p), pr, ranges[p], sign });
+    }
+
+    // 2️⃣ Pass 1: Zeilenlängen zählen
+    //    (prozedurale nur für die Statistik, sie bekommen keine Slots)
+    std::unique_ptr<std::atomic<int>[]> counts(new std::atomic<int>[N]());
+    std::atomic<size_t> n_proc{0};
+    for (size_t p = 0; p < spec.projections.size(); ++p) {
+        const auto& g  = ranges[p];
+        const auto& pr = spec.projections[p];
+        if (pr.procedural) {
+            std::atomic<size_t> n_p{0};
+            parallel_for(T, g.ns, [&](int b, int e) {
+                std::vector<int> scratch;
+                size_t c = 0;
+                for (int i = b; i < e; ++i)
+                    for_each_target(spec.seed, static_cast<int>(p), pr, g, i, scratch, [&](int) { ++c; });
+                n_p.fetch_add(c, std::memory_order_relaxed);
+            });
+            for (auto& pp : procedural)
+                if (pp.proj == static_cast<int>(p)) pp.count = n_p.load();
+            n_proc += n_p.load();
+        } else if (pr.rule == ConnRule::FixedIn) {
+            parallel_for(T, g.nd, [&](int b, int e) {
+                std::vector<int> src;
+                for (int j = b; j < e; ++j) {
+                    sources_of(spec.seed, static_cast<int>(p), pr, g, j, src);
+                    for (int i : src) counts[g.s0 + i].fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        } else {
+            parallel_for(T, g.ns, [&](int b, int e) {
+                std::vector<int> scratch;
+                for (int i = b; i < e; ++i) {
+                    int c = 0;
+                    for_each_target(spec.seed, static_cast<int>(p), pr, g, i, scratch, [&](int) { ++c; });
+                    counts[g.s0 + i].fetch_add(c, std::memory_order_relaxed);
+                }
+            });
+        }
+    }
+    n_procedural = n_proc.load();
+
+    // 3️⃣ paralleler Prefix-Sum -> pre_offsets
+    std::vector<int> offsets(N + 1, 0);
+    {
+        const int chunks = std::max(1, std::min(T, N));
+        const int chunk  = (N + chunks - 1) / chunks;
+        std::vector<long long> part(chunks + 1, 0);
+        parallel_for(T, chunks, [&](int b, int e) {
+            for (int c = b; c < e; ++c) {
+                long long sum = 0;
+                for (int i = c * chunk; i < std::min(N, (c + 1) * chunk); ++i) sum += counts[i].load();
+                part[c + 1] = sum;
+            }
+        });
+        for (int c = 0; c < chunks; ++c) part[c + 1] += part[c];
+        if (part[chunks] > std::numeric_limits<int>::max())
+            throw std::runtime_error("Zu viele Synapsen für 32-Bit-Offsets");
+        parallel_for(T, chunks, [&](int b, int e) {
+            for (int c = b; c < e; ++c) {
+                long long run = part[c];
+                for (int i = c * chunk; i < std::min(N, (c + 1) * chunk); ++i) {
+                    offsets[i] = static_cast<int>(run);
+                    run += counts[i].load();
+                }
+            }
+        });
+        offsets[N] = static_cast<int>(part[chunks]);
+    }
+    const size_t S = static_cast<size_t>(offsets[N]);
+
+    // 4️⃣ Pass 2: Zeilen füllen (Cursor pro Zeile)
+    for (int i = 0; i < N; ++i) counts[i].store(offsets[i], std::memory_order_relaxed);
+    pvector<uint32_t>     target(S);   // ungefüllt: erste Berührung durch die Builder-Threads
+    std::vector<float>    w(S);
+
+    auto emit = [&](const ProjectionSpec& pr, CounterRng& rv, int pre, int post) {
+        const float sign = (pops[pr.src].role == PopRole::Inhibitory) ? -1.0f : 1.0f;
+        const float wv   = sign * std::fabs(pr.weight.sample(rv));
+        const int   d    = sample_delay_ticks(pr.delay_ms, rv, dt_ms);
+        const int   pos  = counts[pre].fetch_add(1, std::memory_order_relaxed);
+        target[pos] = SynapseStore::pack_target(post, d, pr.plastic);
+        w[pos]      = wv;
+    };
+
+    for (size_t p = 0; p < spec.projections.size(); ++p) {
+        const auto& g  = ranges[p];
+        const auto& pr = spec.projections[p];
+        if (pr.procedural) continue;
+        if (pr.rule == ConnRule::FixedIn) {
+            parallel_for(T, g.nd, [&](int b, int e) {
+                std::vector<int> src;
+                for (int j = b; j < e; ++j) {
+                    CounterRng rv(spec.seed, p, static_cast<uint64_t>(g.d0 + j), kValues);
+                    sources_of(spec.seed, static_cast<int>(p), pr, g, j, src);
+                    for (int i : src) emit(pr, rv, g.s0 + i, g.d0 + j);
+                }
+            });
+        } else {
+            parallel_for(T, g.ns, [&](int b, int e) {
+                std::vector<int> scratch;
+                for (int i = b; i < e; ++i) {
+                    CounterRng rv(spec.seed, p, static_cast<uint64_t>(g.s0 + i), kValues);
+                    for_each_target(spec.seed, static_cast<int>(p), pr, g, i, scratch,
+                                    [&](int j) { emit(pr, rv, g.s0 + i, g.d0 + j); });
+                }
+            });
+        }
+    }
+
+    // 5️⃣ lokale Sorts pro Zeile (Reihenfolge aus Pass 2 hängt von Threads ab)
+    parallel_for(T, N, [&](int b, int e) {
+        std::vector<std::pair<uint32_t, float>> row;
+        for (int pre = b; pre < e; ++pre) {
+            const int rb = offsets[pre], re = offsets[pre + 1];
+            row.clear();
+            for (int k = rb; k < re; ++k) row.emplace_back(target[k], w[k]);
+            std::sort(row.begin(), row.end(), row_less);
+            for (int k = rb; k < re; ++k) {
+                target[k] = row[k - rb].first;
+                w[k]      = row[k - rb].second;
+            }
+        }
+    });
+
+    float w_abs_max = std::max(std::fabs(wmin), std::fabs(wmax));
+    for (const auto& pr : spec.projections) w_abs_max = std::max(w_abs_max, pr.weight.abs_bound());
+
+    // 6️⃣ plastische und feste Synapsen in getrennte Stores (Reihenfolge je Zeile bleibt)
+    std::vector<int> off_p(N + 1, 0), off_s(N + 1, 0);
+    parallel_for(T, N, [&](int b, int e) {
+        for (int pre = b; pre < e; ++pre) {
+            int np = 0;
+            for (int k = offsets[pre]; k < offsets[pre + 1]; ++k)
+                np += learns((target[k] & SynapseStore::kPlasticBit) != 0, w[k]);
+            off_p[pre + 1] = np;
+            off_s[pre + 1] = offsets[pre + 1] - offsets[pre] - np;
+        }
+    });
+    for (int i = 0; i < N; ++i) {
+        off_p[i + 1] += off_p[i];
+        off_s[i + 1] += off_s[i];
+    }
+    // target und Gewichte schreibt der Worker, dem die Pre-Zeilen gehören (First Touch)
+    pvector<uint32_t>  tp(off_p[N]), ts(off_s[N]);
+    std::vector<float> wp(off_p[N]), ws(off_s[N]);
+    const RowRunner rows_of_owner = store_rows();
+    rows_of_owner([&](int b, int e) {
+        for (int pre = b; pre < e; ++pre) {
+            int p = off_p[pre], q = off_s[pre];
+            for (int k = offsets[pre]; k < offsets[pre + 1]; ++k) {
+                if (learns((target[k] & SynapseStore::kPlasticBit) != 0, w[k])) {
+                    tp[p] = target[k];
+                    wp[p++] = w[k];
+                } else {
+                    ts[q] = target[k] & ~SynapseStore::kPlasticBit;
+                    ws[q++] = w[k];
+                }
+            }
+        }
+    });
+    target = {};
+    w = {};
+
+    syn.rows.set_dense(off_p);
+    syn.target = std::move(tp);
+    syn.pack_weights(wp, weight_format, w_abs_max, rows_of_owner);
+    syn_static.rows.set_dense(off_s);
+    syn_static.target = std::move(ts);
+    syn_static.pack_weights(ws, weight_format, w_abs_max, rows_of_owner);
+
+    init_runtime();
+}
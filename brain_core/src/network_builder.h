@@ -0,0 +1,30 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include "net.h"
+#include "connectivity.h"
+
+// Deklarativer Netz-Aufbau: Populationen + Projektionen aus einer JSON-Datei.
+// Beispiel: config/demo_net.json
+
+struct PopulationSpec {
+    std::string name;
+    int size = 0;
+    PopRole role = PopRole::Excitatory;
+    NeuronModel model = NeuronModel::LIF;
+};
+
+struct NetSpec {
+    uint64_t seed = 123;
+    int threads = 0;               // 0 = alle Kerne
+    std::vector<PopulationSpec> populations;
+    std::vector<ProjectionSpec> projections;
+    nlohmann::json params = nlohmann::json::object();  // Net-Parameter (learning_rate, Aplus, ...)
+
+    int total_neurons() const;
+};
+
+NetSpec parse_net_spec(const nlohmann::json& j);
+NetSpec load_net_spec(const std::string& path);
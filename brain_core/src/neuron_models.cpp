@@ -0,0 +1,17 @@
+#include "neuron_models.h"
+#include <stdexcept>
+
+NeuronModel parse_neuron_model(const std::string& s) {
+    if (s == "lif")        return NeuronModel::LIF;
+    if (s == "adex")       return NeuronModel::AdEx;
+    if (s == "izhikevich") return NeuronModel::Izhikevich;
+    throw std::runtime_error("Unbekanntes Neuronen-Modell: " + s + " (lif|adex|izhikevich)");
+}
+
+const char* neuron_model_name(NeuronModel m) {
+    switch (m) {
+    case NeuronModel::AdEx:       return "adex";
+    case NeuronModel::Izhikevich: return "izhikevich";
+    default:                      return "lif";
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <string>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Neuronen-Modelle als Policies: Konstanten sind constexpr, der Kernel ist eine
+// inline-Schleife über einen zusammenhängenden Bereich. Neurons wählt das Modell
+// einmal pro Block (= Population), nicht pro Neuron -> keine virtuellen Aufrufe.
+//
+// Eingang: Isyn eines Ticks wirkt wie beim LIF als Spannungssprung Isyn * dt / tau_m;
+// Izhikevich skaliert auf dieselbe Rheobase, damit Gewichte vergleichbar bleiben.
+enum class NeuronModel : uint8_t { LIF, AdEx, Izhikevich };
+
+NeuronModel parse_neuron_model(const std::string& s);
+const char* neuron_model_name(NeuronModel m);
+
+// Zeiger auf die SoA-Arrays, Kernel laufen über [begin, end)
+struct NeuronView {
+    float*    V;
+    float*    Isyn;
+    uint64_t* spk_bits;     // vom Aufrufer für [begin, end) gelöscht
+    std::vector<int>* out;  // Spike-IDs, aufsteigend
+    float*    ref_left;     // Rest-Refraktärzeit in s
+    float*    aux;          // Zusatzzustand des Blocks, Index i - base
+    int       base;
+    float     dt;
+    float     vth_shift;    // Hormon-Verschiebung der Schwelle
+
+    void fire(int i) const {
+        spk_bits[i >> 6] |= uint64_t{1} << (i & 63);
+        out->push_back(i);
+    }
+};
+
+// Adaptive Exponential Integrate-and-Fire (Brette & Gerstner 2005), Spannungen in Volt,
+// Adaptationsstrom w ebenfalls in Volt (w / gL). Parameter ~ "adapting" aus Naud et al. 2008.
+struct AdExModel {
+    static constexpr float tau_m  = 0.020f;
+    static constexpr float EL     = -0.065f;
+    static constexpr float VT     = -0.050f;
+    static constexpr float DeltaT = 0.002f;
+    static constexpr float Vpeak  = -0.030f;
+    static constexpr float Vreset = -0.058f;
+    static constexpr float a      = 0.17f;     // Unterschwellige Adaptation (a / gL)
+    static constexpr float b      = 0.005f;    // Sprung von w pro Spike
+    static constexpr float tau_w  = 0.300f;
+    static constexpr float t_ref  = 0.002f;
+    static constexpr float aux_init = 0.0f;
+
+    static inline void step(const NeuronView& v, int begin, int end) {
+        const float km = v.dt / tau_m;
+        const float kw = v.dt / tau_w;
+        const float vt = VT + v.vth_shift;
+        for (int i = begin; i < end; ++i) {
+            float x = v.V[i];
+            float& w = v.aux[i - v.base];
+            if (v.ref_left[i] > 0.0f) {      // refraktär: V hält, w läuft weiter
+                v.ref_left[i] -= v.dt;
+                w += kw * (a * (x - EL) - w);
+                continue;
+            }
+            const float dv = (EL - x) + DeltaT * std::exp((x - vt) / DeltaT) - w;
+            w += kw * (a * (x - EL) - w);
+            x += km * (dv + v.Isyn[i]);
+            const bool fired = x >= Vpeak;
+            v.V[i]   = fired ? Vreset : x;
+            w       += fired ? b : 0.0f;
+            v.ref_left[i] = fired ? t_ref : 0.0f;
+            if (fired) v.fire(i);
+        }
+    }
+};
+
+// Izhikevich (2003), "regular spiking"; intern in mV und ms wie im Original,
+// zwei halbe Schritte für v (numerisch stabil bei dt = 1 ms).
+struct IzhikevichModel {
+    static constexpr float a = 0.02f;
+    static constexpr float b = 0.2f;
+    static constexpr float c = -65.0f;
+    static constexpr float d = 8.0f;
+    static constexpr float v_peak = 30.0f;
+    static constexpr float gain = 250.0f;      // Isyn -> Strom: 0.015 (LIF-Rheobase) ~ 3.8 (RS-Rheobase)
+    static constexpr float aux_init = b * c;   // u im Ruhezustand
+
+    static inline void step(const NeuronView& v, int begin, int end) {
+        const float h  = v.dt * 1000.0f;        // ms
+        const float ki = h * gain;
+        for (int i = begin; i < end; ++i) {
+            float x = v.V[i] * 1000.0f + ki * v.Isyn[i];
+            float& u = v.aux[i - v.base];
+            x += 0.5f * h * (0.04f * x * x + 5.0f * x + 140.0f - u);
+            x += 0.5f * h * (0.04f * x * x + 5.0f * x + 140.0f - u);
+            u += h * a * (b * x - u);
+            const bool fired = x >= v_peak;
+            v.V[i]   = (fired ? c : x) * 0.001f;
+            u       += fired ? d : 0.0f;
+            if (fired) v.fire(i);
+        }
+    }
+};
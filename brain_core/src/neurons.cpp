@@ -1,76 +1,165 @@
 #include "neurons.h"
 #include "hormones.h"
 #include <algorithm>
+#include <cmath>
+#include <stdexcept>
 
 void Neurons::init(int n) {
+    resize(n);
+    init_range(0, n);
+}
+
+void Neurons::resize(int n) {
     N = n;
-    V.assign(N, -0.065f);
-    Vth.assign(N, -0.050f);
-    Vrest.assign(N, -0.065f);
-    Vreset.assign(N, -0.070f);
-    ref_left.assign(N, 0.0f);
-    Isyn.assign(N, 0.0f);
-    spk.assign(N, 0);
+    V.resize(N);
+    Vth.resize(N);
+    Vrest.resize(N);
+    Vreset.resize(N);
+    ref_left.resize(N);
+    Isyn.resize(N);
+    spk_bits.assign((N + 63) / 64, 0);
+    spikes.clear();
+    blocks.clear();
+    blocks.push_back({ NeuronModel::LIF, 0, N, {} });
+    update_propagator();
+}
+
+void Neurons::set_model(int begin, int end, NeuronModel m) {
+    // Block aufteilen, in dem [begin, end) liegt
+    for (size_t k = 0; k < blocks.size(); ++k) {
+        NeuronBlock& b = blocks[k];
+        if (begin < b.begin || end > b.end) continue;
+        if (b.model != NeuronModel::LIF) throw std::runtime_error("Neuronen-Modell doppelt gesetzt");
+
+        std::vector<NeuronBlock> parts;
+        if (b.begin < begin) parts.push_back({ NeuronModel::LIF, b.begin, begin, {} });
+        NeuronBlock mid{ m, begin, end, {} };
+        if (m == NeuronModel::AdEx)       mid.aux.assign(end - begin, AdExModel::aux_init);
+        if (m == NeuronModel::Izhikevich) mid.aux.assign(end - begin, IzhikevichModel::aux_init);
+        parts.push_back(std::move(mid));
+        if (end < b.end) parts.push_back({ NeuronModel::LIF, end, b.end, {} });
+
+        blocks.erase(blocks.begin() + k);
+        blocks.insert(blocks.begin() + k, std::make_move_iterator(parts.begin()), std::make_move_iterator(parts.end()));
+        return;
+    }
+    throw std::runtime_error("Neuronen-Modell: Bereich passt in keinen Block");
 }
 
-void Neurons::apply_hormones(const HormoneSystem& H) {
-    for (int i = 0; i < N; ++i) {
+bool Neurons::all_lif() const {
+    for (const auto& b : blocks)
+        if (b.model != NeuronModel::LIF) return false;
+    return true;
+}
 
-        float vth_change = 0.0f;
-        float isyn_factor = 1.0f;
-        float tau_factor  = 1.0f;
-        float tref_factor = 1.0f;
+void Neurons::init_range(int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+        V[i]        = -0.065f;
+        Vth[i]      = -0.050f;
+        Vrest[i]    = -0.065f;
+        Vreset[i]   = -0.070f;
+        ref_left[i] = 0.0f;
+        Isyn[i]     = 0.0f;
+    }
+}
 
-        // --- Einfluss der Hormone ---
-        vth_change += -0.010f * H.current.dopamine;
-        vth_change += +0.015f * H.current.melatonin;
-        vth_change += -0.020f * H.current.cortisol;
-        vth_change += -0.005f * H.current.endorphin;
-        vth_change += -0.010f * H.current.adrenaline;
+void Neurons::update_propagator() {
+    prop = std::exp(-dt / tau_m);
+}
 
-        isyn_factor *= (1.0f + 0.5f * H.current.adrenaline);
-        isyn_factor *= (1.0f + 0.2f * H.current.dopamine);
-        isyn_factor *= (1.0f - 0.3f * H.current.oxytocin);
+void Neurons::apply_hormones(const HormoneSystem& H, float elapsed) {
+    float vth_change = 0.0f;
+    float tau_factor  = 1.0f;
+    float tref_factor = 1.0f;
 
-        tau_factor  *= (1.0f + 0.3f * H.current.noradrenaline - 0.2f * H.current.acetylcholine);
-        tref_factor *= (1.0f + 0.4f * H.current.melatonin - 0.2f * H.current.endorphin);
+    // --- Einfluss der Hormone ---
+    vth_change += -0.010f * H.current.dopamine;
+    vth_change += +0.015f * H.current.melatonin;
+    vth_change += -0.020f * H.current.cortisol;
+    vth_change += -0.005f * H.current.endorphin;
+    vth_change += -0.010f * H.current.adrenaline;
 
-        // --- Anwenden ---
-        Vth[i] += vth_change * dt;
-        Vth[i] = std::clamp(Vth[i], -0.080f, -0.030f);
+    tau_factor  *= (1.0f + 0.3f * H.current.noradrenaline - 0.2f * H.current.acetylcholine);
+    tref_factor *= (1.0f + 0.4f * H.current.melatonin - 0.2f * H.current.endorphin);
 
-        tau_m  = 0.020f * tau_factor;
-        tref   = 0.002f * tref_factor;
+    // --- Anwenden ---
+    // Die Änderung ist für alle Neuronen gleich, deshalb nur ein Offset statt Vth[i] += ...
+    // Grenzen relativ zur Basis-Schwelle -0.050 (entspricht Vth in [-0.080, -0.030]).
+    // Die Drift ist über die Periode konstant -> linear in elapsed, also exakt.
+    vth_shift = std::clamp(vth_shift + vth_change * elapsed, -0.030f, 0.020f);
 
-        Isyn[i] *= isyn_factor;
+    const float new_tau = 0.020f * tau_factor;
+    tref   = 0.002f * tref_factor;
+    if (new_tau != tau_m) {
+        tau_m = new_tau;
+        update_propagator();
+    }
+}
+
+void Neurons::clear_spikes() {
+    for (int i : spikes) spk_bits[i >> 6] &= ~(uint64_t{1} << (i & 63));
+    spikes.clear();
+}
+
+void Neurons::set_spikes(const std::vector<int>& ids) {
+    std::fill(spk_bits.begin(), spk_bits.end(), 0);
+    spikes.clear();
+    for (int i : ids) mark_spike(i);
+}
+
+void Neurons::clear_bits(int begin, int end) {
+    if (begin >= end) return;
+    // Randwörter nur maskiert: der Rest gehört evtl. einem anderen Bereich / Prozess
+    const int wb = begin >> 6, we = (end - 1) >> 6;
+    for (int w = wb; w <= we; ++w) {
+        const int lo = (w == wb) ? (begin & 63) : 0;
+        const int hi = (w == we) ? ((end - 1) & 63) : 63;
+        spk_bits[w] &= ~((~uint64_t{0} >> (63 - hi)) & (~uint64_t{0} << lo));
     }
 }
 
 void Neurons::step() {
-    for (int i = 0; i < N; ++i) {
+    step_range(0, N, spikes);
+}
 
-        // Input-Neuronen überspringen, sie feuern nur extern
-        if (input_neurons && std::find(input_neurons->begin(), input_neurons->end(), i) != input_neurons->end()) {
-            spk[i] = 0;
-            V[i] = Vrest[i];
-            Isyn[i] = 0.0f;
-            continue;
+void Neurons::step_range(int begin, int end, std::vector<int>& out) {
+    out.clear();
+    clear_bits(begin, end);
+
+    // einmal pro Block verzweigen, darin läuft der Kernel des Modells ohne Dispatch
+    for (auto& b : blocks) {
+        const int lo = std::max(begin, b.begin), hi = std::min(end, b.end);
+        if (lo >= hi) continue;
+        switch (b.model) {
+        case NeuronModel::LIF:        step_lif(lo, hi, out); break;
+        case NeuronModel::AdEx:       step_model<AdExModel>(b, lo, hi, out); break;
+        case NeuronModel::Izhikevich: step_model<IzhikevichModel>(b, lo, hi, out); break;
         }
-        
-        spk[i] = 0;
+    }
+    std::fill(Isyn.begin() + begin, Isyn.begin() + end, 0.0f);
+}
+
+template <class M>
+void Neurons::step_model(NeuronBlock& b, int begin, int end, std::vector<int>& out) {
+    const NeuronView v{ V.data(), Isyn.data(), spk_bits.data(), &out, ref_left.data(), b.aux.data(), b.begin, dt, vth_shift };
+    M::step(v, begin, end);
+}
+
+void Neurons::step_lif(int begin, int end, std::vector<int>& out) {
+    for (int i = begin; i < end; ++i) {
+
         if (ref_left[i] > 0.0f) {
             ref_left[i] -= dt;
             V[i] = Vreset[i];
             continue;
         }
-        const float dV = (-(V[i] - Vrest[i]) + Isyn[i]) * (dt / tau_m);
-        V[i] += dV;
+        V[i] = Vrest[i] + (V[i] - Vrest[i]) * prop + Isyn[i] * (1.0f - prop);
 
-        if (V[i] >= Vth[i]) {
+        if (V[i] >= threshold(i)) {
             V[i] = Vreset[i];
             ref_left[i] = tref;
-            spk[i] = 1;
+            spk_bits[i >> 6] |= uint64_t{1} << (i & 63);
+            out.push_back(i);
         }
     }
-    std::fill(Isyn.begin(), Isyn.end(), 0.0f);
 }
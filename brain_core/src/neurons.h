@@ -1,23 +1,73 @@
 #pragma once
 #include <vector>
 #include <cstdint>
+#include <algorithm>
 #include "hormones.h"
+#include "placement.h"
+#include "neuron_models.h"
+
+// zusammenhängender Bereich mit einem Modell (eine Population) und eigenem Zusatzzustand
+struct NeuronBlock {
+    NeuronModel model = NeuronModel::LIF;
+    int begin = 0, end = 0;
+    pvector<float> aux;      // AdEx: w, Izhikevich: u, LIF: leer
+};
 
 class Neurons {
 public:
     int N = 0;
 
-    std::vector<float> V, Vth, Vrest, Vreset, ref_left;
-    std::vector<float> Isyn;
-    std::vector<uint8_t> spk;
-    std::vector<int>* input_neurons = nullptr;
+    pvector<float> V, Vth, Vrest, Vreset, ref_left;
+    pvector<float> Isyn;
+
+    // Spikes des letzten Updates in zwei Formen, beide schreibt der Kernel beim Feuern:
+    //  spk_bits: 1 Bit pro Neuron in 64er-Wörtern -> O(1)-Abfrage, bleibt auch bei großem N im Cache
+    //  spikes:   IDs aufsteigend -> Routing, Zählen, Logger zahlen pro Spike statt pro Neuron
+    std::vector<uint64_t> spk_bits;
+    std::vector<int>      spikes;
+
+    bool spiked(int i) const { return (spk_bits[i >> 6] >> (i & 63)) & 1u; }
+    void mark_spike(int i) {                 // Event-Modus (feuert außerhalb von step_range)
+        spk_bits[i >> 6] |= uint64_t{1} << (i & 63);
+        spikes.push_back(i);
+    }
+    void clear_spikes();                     // Bits der Liste löschen, O(Spikes)
+    void set_spikes(const std::vector<int>& ids);   // Checkpoint: Liste setzen, Bits nachziehen
 
     float tau_m = 0.020f;  
     float tref  = 0.002f;  
     float dt    = 0.001f;  
 
-    void init(int n);
-    void apply_hormones(const HormoneSystem& H);
-    void step();
+    // Hormon-Verschiebung der Schwelle, für alle Neuronen gleich (O(1) statt O(N) pro Tick)
+    float vth_shift = 0.0f;
+
+    // Exakter LIF-Propagator für einen Tick: V = Vrest + (V - Vrest) * P + I * (1 - P)
+    // mit P = exp(-dt / tau_m). Wird neu berechnet, wenn sich tau_m ändert.
+    float prop = 0.0f;
+
+    // Modell-Blöcke, aufsteigend und lückenlos über [0, N); resize() legt einen LIF-Block an
+    std::vector<NeuronBlock> blocks;
+
+    void init(int n);                 // resize + init_range(0, n)
+    void set_model(int begin, int end, NeuronModel m);   // Bereich = Grenzen der Population
+    bool all_lif() const;
+    void resize(int n);               // Speicher ohne Anfassen (First Touch später)
+    void init_range(int begin, int end);
+    // elapsed: Zeit seit dem letzten Aufruf (Modulations-Periode, Vielfaches von dt)
+    void apply_hormones(const HormoneSystem& H, float elapsed);
+    void update_propagator();
+    void step();                          // ganzes Netz, IDs nach `spikes`
+    // Partition [begin, end), unabhängig von den anderen: Bits des Bereichs, IDs nach `out`.
+    // Grenzen mehrerer Worker auf 64 runden, sonst teilen sie sich ein Bit-Wort
+    void step_range(int begin, int end, std::vector<int>& out);
+
+private:
+    void clear_bits(int begin, int end);
+    void step_lif(int begin, int end, std::vector<int>& out);
+    template <class M> void step_model(NeuronBlock& b, int begin, int end, std::vector<int>& out);
+
+public:
+    // effektive Schwelle von Neuron i
+    float threshold(int i) const { return std::clamp(Vth[i] + vth_shift, -0.080f, -0.030f); }
 
 };
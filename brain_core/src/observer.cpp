@@ -0,0 +1,94 @@
+#include "observer.h"
+#include "net.h"
+#include "io_logger.h"
+#include <chrono>
+#include <algorithm>
+
+ObserverHub::~ObserverHub() {
+    stop();
+}
+
+void ObserverHub::configure(std::vector<int> probes, std::vector<std::pair<int, int>> ranges) {
+    probes_ = std::move(probes);
+    ranges_ = std::move(ranges);
+    range_total_.assign(ranges_.size(), 0);
+}
+
+void ObserverHub::add(std::string name, Observer fn) {
+    observers_.emplace_back(std::move(name), std::move(fn));
+}
+
+void ObserverHub::start() {
+    stop_ = false;
+    worker_ = std::thread(&ObserverHub::run, this);
+}
+
+void ObserverHub::stop() {
+    if (!worker_.joinable()) return;
+    stop_ = true;
+    cv_.notify_one();
+    worker_.join();
+}
+
+void ObserverHub::publish(const Net& net, long step, double step_us, uint8_t marks) {
+    Snapshot& s = tb_.back();
+
+    // 1️⃣ Spike-Liste und Zählbereiche in einem Durchlauf (IDs steigen, Bereiche auch)
+    s.spikes.assign(net.neu.spikes.begin(), net.neu.spikes.end());
+    size_t r = 0;
+    for (int i : s.spikes) {
+        while (r < ranges_.size() && i >= ranges_[r].second) ++r;
+        if (r < ranges_.size() && i >= ranges_[r].first) ++range_total_[r];
+    }
+    total_   += s.spikes.size();
+    step_us_ += step_us;
+
+    // 2️⃣ aktueller Zustand + kumulative Zähler
+    s.tick     = net.tick;
+    s.step     = step;
+    s.hormones = net.H.current;
+    s.probe_V.resize(probes_.size());
+    for (size_t p = 0; p < probes_.size(); ++p) s.probe_V[p] = net.neu.V[probes_[p]];
+    s.total_spikes = total_;
+    s.range_spikes = range_total_;
+    s.step_us      = step_us_;
+
+    // 3️⃣ Ereignisse: alle noch nicht bestätigten mitgeben (meist 0-1 Einträge)
+    for (const auto& tk : net.readout.decoded) tokens_.push(tk);
+    if (marks)
+        samples_.push({ marks, s.tick, step, static_cast<int>(s.spikes.size()), s.hormones, s.spikes, s.probe_V,
+                        range_total_, step_us_ });
+    samples_.copy_to(s.samples, s.samples_seq);
+    tokens_.copy_to(s.tokens, s.tokens_seq);
+
+    // 4️⃣ Zeiger tauschen
+    if (tb_.publish()) ++skipped_;
+    ++published_;
+    cv_.notify_one();
+}
+
+void ObserverHub::run() {
+    for (;;) {
+        if (Snapshot* s = tb_.take()) {
+            // Ereignisse, die schon mit einem früheren Snapshot kamen, nicht doppelt melden
+            ack_events(samples_, s->samples, s->samples_seq);
+            ack_events(tokens_, s->tokens, s->tokens_seq);
+
+            for (auto& [name, fn] : observers_) {
+                try {
+                    fn(*s);
+                } catch (const std::exception& e) {
+                    IoLogger::instance().log_error("Beobachter " + name + ": " + e.what());
+                }
+            }
+            continue;
+        }
+        if (stop_) {
+            if (!tb_.fresh()) break;   // letzter Snapshot kann kurz vor stop() gekommen sein
+            continue;
+        }
+        // notify_one ohne Lock kann verpasst werden -> kurzer Timeout statt Lock im Sim-Thread
+        std::unique_lock<std::mutex> lock(mtx_);
+        cv_.wait_for(lock, std::chrono::milliseconds(2), [&] { return stop_ || tb_.fresh(); });
+    }
+}
@@ -0,0 +1,150 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <cstdint>
+#include <deque>
+#include <algorithm>
+#include "hormones.h"
+#include "readout.h"
+
+class Net;
+
+// Drei Puffer, ein Schreiber, ein Leser: Veröffentlichen und Abholen sind je ein
+// atomarer Tausch von Indizes. Der Schreiber wartet nie, der Leser sieht immer den
+// neuesten fertigen Puffer (ältere, ungelesene werden übersprungen).
+template <class T>
+class TripleBuffer {
+public:
+    T& back() { return buf_[back_]; }
+
+    // back <-> middle. true: der vorige Puffer wurde nicht gelesen und liegt jetzt wieder in back()
+    bool publish() {
+        const uint8_t old = state_.exchange(static_cast<uint8_t>(back_ | kFresh), std::memory_order_acq_rel);
+        back_ = old & kIndex;
+        return (old & kFresh) != 0;
+    }
+
+    bool fresh() const { return (state_.load(std::memory_order_acquire) & kFresh) != 0; }
+
+    // middle -> front, falls neu; sonst nullptr. front gehört bis zum nächsten take() dem Leser
+    T* take() {
+        if (!fresh()) return nullptr;
+        const uint8_t old = state_.exchange(front_, std::memory_order_acq_rel);
+        front_ = old & kIndex;
+        return &buf_[front_];
+    }
+
+private:
+    static constexpr uint8_t kIndex = 3, kFresh = 4;
+    T buf_[3];
+    uint8_t back_ = 0, front_ = 1;
+    std::atomic<uint8_t> state_{2};   // middle-Index | kFresh
+};
+
+// Zustand nach einem Tick, wie ihn Beobachter sehen.
+//  - "aktuell": gilt für `tick`, geht beim Überspringen verloren
+//  - kumulativ: Differenzen zweier Snapshots = Summe der Ticks dazwischen
+//  - Ereignisse: gehen nie verloren; jeder Snapshot trägt alle, die der Leser noch
+//    nicht bestätigt hat (Seq-Nummern, der Hub reicht jedes genau einmal weiter)
+struct Snapshot {
+    // markierter Tick (Log, Telemetrie): Momentaufnahme + kumulative Zähler
+    enum Mark : uint8_t { kLog = 1, kTelemetry = 2 };
+    struct Sample {
+        uint8_t marks = 0;
+        long tick = 0, step = 0;
+        int  spike_count = 0;
+        HormoneSet hormones;
+        std::vector<int>      spike_ids;
+        std::vector<float>    probe_V;
+        std::vector<uint64_t> range_spikes;
+        double step_us = 0.0;
+    };
+
+    // aktuell
+    long tick = 0;                      // Net::tick nach dem Schritt
+    long step = 0;                      // Schrittzähler der Hauptschleife
+    std::vector<int>   spikes;          // IDs, aufsteigend
+    HormoneSet         hormones;
+    std::vector<float> probe_V;         // V der Probe-Neuronen
+
+    // kumulativ
+    uint64_t total_spikes = 0;
+    std::vector<uint64_t> range_spikes; // pro Bereich aus configure()
+    double   step_us = 0.0;             // Summe der Schrittzeiten
+
+    // noch nicht bestätigte Ereignisse, *_seq = Seq des ersten Eintrags
+    std::vector<Sample> samples;
+    std::vector<Readout::Token> tokens;
+    uint64_t samples_seq = 0, tokens_seq = 0;
+};
+
+// Beobachter (Logger, Readout, Telemetrie, ...) laufen auf einem eigenen Thread.
+// Der Sim-Thread füllt pro Tick einen Snapshot und tauscht einen Zeiger: kein I/O,
+// kein Lock, Kosten unabhängig von der Zahl der Beobachter.
+class ObserverHub {
+public:
+    using Observer = std::function<void(const Snapshot&)>;
+
+    ~ObserverHub();
+
+    // Probe-Neuronen und Zählbereiche [begin, end) (aufsteigend, disjunkt)
+    void configure(std::vector<int> probes, std::vector<std::pair<int, int>> ranges);
+    void add(std::string name, Observer fn);   // vor start()
+    void start();
+    void stop();                               // letzten Snapshot noch abarbeiten
+
+    // Sim-Thread, nach step_once. marks != 0: diesen Tick als Ereignis festhalten (Snapshot::Mark)
+    void publish(const Net& net, long step, double step_us, uint8_t marks);
+
+    uint64_t published() const { return published_; }
+    uint64_t skipped() const   { return skipped_; }
+
+private:
+    void run();
+
+    // Ereignisse bis zur Bestätigung durch den Leser (ack = Seq hinter dem letzten gelesenen)
+    template <class E>
+    struct EventLog {
+        std::deque<E> pending;
+        uint64_t end = 0;                      // Seq hinter dem letzten Eintrag
+        std::atomic<uint64_t> ack{0};
+
+        void push(E e) { pending.push_back(std::move(e)); ++end; }
+        void copy_to(std::vector<E>& out, uint64_t& first) {
+            const uint64_t a = ack.load(std::memory_order_acquire);
+            while (!pending.empty() && end - pending.size() < a) pending.pop_front();
+            out.assign(pending.begin(), pending.end());
+            first = end - pending.size();
+        }
+    };
+
+    // Leser: schon gemeldete Ereignisse vorne abschneiden, Rest bestätigen
+    template <class E>
+    static void ack_events(EventLog<E>& log, std::vector<E>& v, uint64_t first) {
+        const uint64_t seen = log.ack.load(std::memory_order_relaxed);
+        const uint64_t end  = first + v.size();
+        if (seen > first) v.erase(v.begin(), v.begin() + std::min<uint64_t>(seen - first, v.size()));
+        if (end > seen) log.ack.store(end, std::memory_order_release);
+    }
+
+    TripleBuffer<Snapshot> tb_;
+    EventLog<Snapshot::Sample> samples_;
+    EventLog<Readout::Token>   tokens_;
+    std::vector<int> probes_;
+    std::vector<std::pair<int, int>> ranges_;
+    uint64_t total_ = 0;
+    std::vector<uint64_t> range_total_;
+    double step_us_ = 0.0;
+
+    std::vector<std::pair<std::string, Observer>> observers_;
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::atomic<bool> stop_{false};
+    std::thread worker_;
+    uint64_t published_ = 0, skipped_ = 0;
+};
@@ -0,0 +1,130 @@
+#include "placement.h"
+#include <sys/mman.h>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <cstdlib>
+#include <stdexcept>
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#ifndef MAP_HUGE_2MB
+#define MAP_HUGE_2MB (21 << MAP_HUGE_SHIFT)
+#endif
+#ifndef MAP_HUGE_1GB
+#define MAP_HUGE_1GB (30 << MAP_HUGE_SHIFT)
+#endif
+
+namespace {
+
+constexpr size_t kMmapMin = size_t(2) << 20;   // ab 2 MB eigene Region
+constexpr size_t k2M = size_t(2) << 20;
+constexpr size_t k1G = size_t(1) << 30;
+
+std::atomic<HugePages> g_mode{HugePages::THP};
+std::atomic<size_t>    g_bytes{0}, g_peak{0}, g_fallbacks{0};
+
+// Region -> gemappte Länge (Freigabe braucht die gerundete Größe der Allokation)
+std::mutex g_mtx;
+std::unordered_map<void*, size_t> g_regions;
+
+size_t round_up(size_t n, size_t a) { return (n + a - 1) / a * a; }
+
+void account(long delta) {
+    const size_t now = g_bytes.fetch_add(static_cast<size_t>(delta)) + static_cast<size_t>(delta);
+    size_t peak = g_peak.load();
+    while (now > peak && !g_peak.compare_exchange_weak(peak, now)) {}
+}
+
+// normale Seiten, auf 2 MB ausgerichtet (Voraussetzung für THP)
+void* map_aligned(size_t len) {
+    const size_t over = len + k2M;
+    char* raw = static_cast<char*>(mmap(nullptr, over, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (raw == MAP_FAILED) return nullptr;
+    char* p = reinterpret_cast<char*>(round_up(reinterpret_cast<uintptr_t>(raw), k2M));
+    if (p > raw) munmap(raw, p - raw);
+    const size_t tail = (raw + over) - (p + len);
+    if (tail) munmap(p + len, tail);
+    return p;
+}
+
+void* map_region(size_t& len) {
+    const HugePages mode = g_mode.load();
+    if (mode == HugePages::Huge2M || mode == HugePages::Huge1G) {
+        const size_t page = (mode == HugePages::Huge1G) ? k1G : k2M;
+        const int    size_flag = (mode == HugePages::Huge1G) ? MAP_HUGE_1GB : MAP_HUGE_2MB;
+        const size_t hl = round_up(len, page);
+        void* p = mmap(nullptr, hl, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | size_flag, -1, 0);
+        if (p != MAP_FAILED) { len = hl; return p; }
+        ++g_fallbacks;   // keine reservierten Huge Pages -> weiter mit THP-Hinweis
+    }
+
+    len = round_up(len, k2M);
+    void* p = map_aligned(len);
+    if (p && mode != HugePages::Off) madvise(p, len, MADV_HUGEPAGE);
+    return p;
+}
+
+} // namespace
+
+void set_huge_pages(HugePages h) { g_mode = h; }
+HugePages huge_pages() { return g_mode.load(); }
+
+HugePages parse_huge_pages(const std::string& s) {
+    if (s == "off") return HugePages::Off;
+    if (s == "thp") return HugePages::THP;
+    if (s == "2m")  return HugePages::Huge2M;
+    if (s == "1g")  return HugePages::Huge1G;
+    throw std::runtime_error("Unbekannter Huge-Page-Modus: " + s);
+}
+
+PlacementStats placement_stats() {
+    PlacementStats s;
+    s.bytes = g_bytes.load();
+    s.peak  = g_peak.load();
+    s.huge_fallbacks = g_fallbacks.load();
+    std::lock_guard<std::mutex> lock(g_mtx);
+    s.mapped_regions = g_regions.size();
+    return s;
+}
+
+void* placed_alloc(size_t bytes) {
+    if (bytes == 0) bytes = 1;
+    if (bytes < kMmapMin) {
+        void* p = std::malloc(bytes);
+        if (!p) throw std::bad_alloc();
+        account(static_cast<long>(bytes));
+        return p;
+    }
+
+    size_t len = bytes;
+    void* p = map_region(len);
+    if (!p) throw std::bad_alloc();
+    {
+        std::lock_guard<std::mutex> lock(g_mtx);
+        g_regions[p] = len;
+    }
+    account(static_cast<long>(bytes));
+    return p;
+}
+
+void placed_free(void* p, size_t bytes) {
+    if (!p) return;
+    if (bytes == 0) bytes = 1;
+    account(-static_cast<long>(bytes));
+    if (bytes < kMmapMin) {
+        std::free(p);
+        return;
+    }
+    size_t len = 0;
+    {
+        std::lock_guard<std::mutex> lock(g_mtx);
+        auto it = g_regions.find(p);
+        if (it == g_regions.end()) return;
+        len = it->second;
+        g_regions.erase(it);
+    }
+    munmap(p, len);
+}
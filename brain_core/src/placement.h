@@ -0,0 +1,82 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <new>
+#include <type_traits>
+#include <string>
+
+// Speicher-Platzierung für die großen Zustands-Arrays (Neuronen, Traces, Synapsen).
+//
+//  - Große Blöcke (>= 2 MB) kommen direkt per mmap, 2 MB-ausgerichtet, optional
+//    mit Huge Pages (THP per madvise oder explizit MAP_HUGETLB 2 MB / 1 GB).
+//  - resize() ohne Wert fasst den Speicher NICHT an (Default-Init). Die Seiten
+//    landen dadurch beim ersten Schreiben auf dem NUMA-Knoten des schreibenden
+//    Threads (First Touch) – Net füllt sie partitionsweise aus den Worker-Threads.
+//  - Kleine Blöcke: normaler Heap.
+enum class HugePages : uint8_t {
+    Off,   // nur mmap, keine Hinweise
+    THP,   // madvise(MADV_HUGEPAGE), Default
+    Huge2M,
+    Huge1G
+};
+
+struct PlacementStats {
+    size_t bytes = 0;          // aktuell belegt (alle placed-Allokationen)
+    size_t peak = 0;           // Höchststand
+    size_t mapped_regions = 0; // aktuelle mmap-Regionen
+    size_t huge_fallbacks = 0; // MAP_HUGETLB fehlgeschlagen -> normale Seiten
+};
+
+// Speicherbilanz einer Struktur: belegt (size) und reserviert (capacity, >= bytes)
+struct MemUse {
+    size_t bytes = 0;
+    size_t reserved = 0;
+    MemUse& operator+=(const MemUse& o) {
+        bytes += o.bytes;
+        reserved += o.reserved;
+        return *this;
+    }
+};
+
+template <class V>
+MemUse mem_of(const V& v) {
+    using T = typename V::value_type;
+    return { v.size() * sizeof(T), v.capacity() * sizeof(T) };
+}
+inline MemUse mem_of(const std::vector<bool>& v) { return { (v.size() + 7) / 8, (v.capacity() + 7) / 8 }; }
+
+void           set_huge_pages(HugePages h);
+HugePages      huge_pages();
+HugePages      parse_huge_pages(const std::string& s);
+PlacementStats placement_stats();
+
+void* placed_alloc(size_t bytes);
+void  placed_free(void* p, size_t bytes);
+
+template <class T>
+struct PlacedAllocator {
+    using value_type = T;
+
+    PlacedAllocator() noexcept = default;
+    template <class U> PlacedAllocator(const PlacedAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) { return static_cast<T*>(placed_alloc(n * sizeof(T))); }
+    void deallocate(T* p, size_t n) noexcept { placed_free(p, n * sizeof(T)); }
+
+    // Default-Init statt Value-Init: resize(n) schreibt nichts (First Touch später)
+    template <class U>
+    void construct(U* p) noexcept(std::is_nothrow_default_constructible<U>::value) {
+        ::new (static_cast<void*>(p)) U;
+    }
+    template <class U, class... Args>
+    void construct(U* p, Args&&... args) {
+        ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+
+    template <class U> bool operator==(const PlacedAllocator<U>&) const noexcept { return true; }
+    template <class U> bool operator!=(const PlacedAllocator<U>&) const noexcept { return false; }
+};
+
+template <class T>
+using pvector = std::vector<T, PlacedAllocator<T>>;
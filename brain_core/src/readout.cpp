@@ -0,0 +1,97 @@
+#include "readout.h"
+#include <algorithm>
+#include "binary_io.h"
+
+std::vector<std::string> Readout::phonemes() {
+    return {"a","b","c","d","e","f","g","h","i","j","k","l","m","n","o","p","q","r","s","t","u","v","w","x","y","z","ä","ö","ü",",","."," "};
+}
+
+void Readout::init(const std::vector<int>& output_target, int n_neurons) {
+    if (inventory.empty()) inventory = phonemes();
+    window = std::max(1, window);
+
+    out_index_.assign(n_neurons, -1);
+    neuron_of_ = output_target;
+    for (size_t o = 0; o < output_target.size(); ++o)
+        out_index_[output_target[o]] = static_cast<int>(o);
+
+    count_.assign(output_target.size(), 0);
+    above_.assign(output_target.size(), 0);
+    ring_.assign(window, {});
+    decoded.clear();
+    dirty_ = false;
+    winner_ = -1;
+}
+
+MemUse Readout::memory() const {
+    MemUse m = mem_of(out_index_);
+    m += mem_of(neuron_of_);
+    m += mem_of(count_);
+    m += mem_of(above_);
+    m += mem_of(ring_);
+    for (const auto& b : ring_) m += mem_of(b);
+    return m;
+}
+
+void Readout::advance(long tick) {
+    // Bucket von Tick - window fällt aus dem Fenster
+    auto& old = ring_[tick % window];
+    if (old.empty()) return;
+    for (int o : old) --count_[o];
+    old.clear();
+    dirty_ = true;
+}
+
+void Readout::on_spike(int neuron, long tick) {
+    const int o = out_index_[neuron];
+    if (o < 0) return;
+    ++count_[o];
+    ring_[tick % window].push_back(o);
+    dirty_ = true;
+}
+
+void Readout::decode(long tick) {
+    if (!dirty_) return;
+    dirty_ = false;
+    if (count_.empty()) return;
+
+    auto emit = [&](int o) {
+        decoded.push_back({ tick, o, neuron_of_[o], count_[o],
+                            inventory[o % inventory.size()] });
+    };
+
+    if (mode == Mode::WTA) {
+        int best = static_cast<int>(std::max_element(count_.begin(), count_.end()) - count_.begin());
+        // Hysterese: ein Herausforderer braucht margin Spikes mehr (kein Flackern)
+        if (winner_ >= 0 && count_[winner_] + margin > count_[best]) best = winner_;
+        const int w = (count_[best] >= threshold) ? best : -1;
+        if (w != winner_ && w >= 0) emit(w);
+        winner_ = w;
+    } else {
+        for (size_t o = 0; o < count_.size(); ++o) {
+            const bool up = count_[o] >= threshold;
+            if (up && !above_[o]) emit(static_cast<int>(o));
+            above_[o] = up;
+        }
+    }
+}
+
+void Readout::save(std::ostream& o) const {
+    bio::put_vec(o, count_);
+    bio::put_vec(o, above_);
+    bio::put<uint64_t>(o, ring_.size());
+    for (const auto& b : ring_) bio::put_vec(o, b);
+    bio::put(o, dirty_);
+    bio::put(o, winner_);
+}
+
+void Readout::load(std::istream& i) {
+    bio::get_vec(i, count_);
+    bio::get_vec(i, above_);
+    uint64_t n = 0;
+    bio::get(i, n);
+    if (n != ring_.size()) throw std::runtime_error("Checkpoint: anderes Readout-Fenster");
+    for (auto& b : ring_) bio::get_vec(i, b);
+    bio::get(i, dirty_);
+    bio::get(i, winner_);
+}
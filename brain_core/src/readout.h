@@ -0,0 +1,57 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <iosfwd>
+#include "placement.h"
+
+// Ausgabe-Kanal: Spike-Zählungen der Output-Neuronen in einem gleitenden Fenster,
+// dekodiert zu Tokens (Phoneme aus PH). Alles inkrementell:
+//  - on_spike(): +1 für das Output-Neuron, Eintrag im Fenster-Bucket des Ticks
+//  - advance():  der älteste Bucket fällt raus (-1 je Eintrag)
+// Kosten ~ Output-Spikes, nicht N.
+class Readout {
+public:
+    enum class Mode {
+        WTA,        // stärkstes Output-Neuron (>= threshold) gewinnt, Token bei Wechsel
+        Threshold   // jedes Neuron, das threshold überschreitet, gibt ein Token (steigende Flanke)
+    };
+
+    struct Token {
+        long tick;
+        int  output;   // Index in output_target
+        int  neuron;
+        int  count;    // Spikes im Fenster beim Dekodieren
+        std::string text;
+    };
+
+    Mode mode = Mode::WTA;
+    int  window = 50;      // Fensterlänge in Ticks
+    int  threshold = 3;    // min. Spikes im Fenster
+    int  margin = 2;       // WTA: so viele Spikes mehr braucht ein neuer Gewinner
+
+    std::vector<std::string> inventory;   // Token pro Output-Neuron (zyklisch)
+    std::vector<Token> decoded;           // neue Tokens, der Aufrufer leert die Liste
+
+    static std::vector<std::string> phonemes();
+
+    void init(const std::vector<int>& output_target, int n_neurons);
+    void advance(long tick);              // am Anfang eines Ticks
+    void on_spike(int neuron, long tick);
+    void decode(long tick);               // am Ende eines Ticks
+
+    const std::vector<int>& counts() const { return count_; }
+    MemUse memory() const;
+
+    void save(std::ostream& o) const;     // Checkpoint (Fenster + Dekoder-Zustand)
+    void load(std::istream& i);
+
+private:
+    std::vector<int> out_index_;          // Neuron -> Output-Index (-1 = kein Output)
+    std::vector<int> neuron_of_;          // Output-Index -> Neuron
+    std::vector<int> count_;
+    std::vector<uint8_t> above_;          // Threshold-Modus: war schon über der Schwelle
+    std::vector<std::vector<int>> ring_;  // pro Tick im Fenster: Output-Indizes der Spikes
+    bool dirty_ = false;
+    int  winner_ = -1;                    // WTA: zuletzt gemeldeter Gewinner
+};
@@ -0,0 +1,78 @@
+#include "shm_ring.h"
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <algorithm>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+void ShmRing::attach(void* mem, size_t capacity, bool init) {
+    h_    = init ? new (mem) Header() : static_cast<Header*>(mem);
+    data_ = static_cast<uint8_t*>(mem) + sizeof(Header);
+    cap_  = capacity;
+}
+
+size_t ShmRing::write_some(const void* src, size_t n, size_t unit) {
+    const uint64_t head = h_->head.load(std::memory_order_relaxed);
+    const uint64_t tail = h_->tail.load(std::memory_order_acquire);
+    size_t len = std::min(n, cap_ - static_cast<size_t>(head - tail));
+    len -= len % unit;
+    if (len == 0) return 0;
+
+    // evtl. in zwei Stücken (Umbruch am Ende des Puffers)
+    const size_t pos   = static_cast<size_t>(head % cap_);
+    const size_t first = std::min(len, cap_ - pos);
+    std::memcpy(data_ + pos, src, first);
+    std::memcpy(data_, static_cast<const uint8_t*>(src) + first, len - first);
+    h_->head.store(head + len, std::memory_order_release);
+    return len;
+}
+
+size_t ShmRing::read_some(void* dst, size_t n, size_t unit) {
+    const uint64_t tail = h_->tail.load(std::memory_order_relaxed);
+    const uint64_t head = h_->head.load(std::memory_order_acquire);
+    size_t len = std::min(n, static_cast<size_t>(head - tail));
+    len -= len % unit;
+    if (len == 0) return 0;
+
+    const size_t pos   = static_cast<size_t>(tail % cap_);
+    const size_t first = std::min(len, cap_ - pos);
+    std::memcpy(dst, data_ + pos, first);
+    std::memcpy(static_cast<uint8_t*>(dst) + first, data_, len - first);
+    h_->tail.store(tail + len, std::memory_order_release);
+    return len;
+}
+
+size_t ShmRing::readable() const {
+    return static_cast<size_t>(h_->head.load(std::memory_order_acquire)
+                               - h_->tail.load(std::memory_order_relaxed));
+}
+
+ShmSegment::~ShmSegment() {
+    if (base_) munmap(base_, bytes_);
+}
+
+void ShmSegment::create(const std::string& name, size_t bytes) {
+    const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) throw std::runtime_error("shm_open fehlgeschlagen: " + name);
+    if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        close(fd);
+        shm_unlink(name.c_str());
+        throw std::runtime_error("Shared Memory zu klein: " + name);
+    }
+    void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) {
+        shm_unlink(name.c_str());
+        throw std::runtime_error("mmap fehlgeschlagen: " + name);
+    }
+    name_ = name;
+    base_ = p;
+    bytes_ = bytes;
+}
+
+void ShmSegment::unlink() {
+    if (!name_.empty()) shm_unlink(name_.c_str());
+    name_.clear();
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Single-Producer/Single-Consumer-Bytering in geteiltem Speicher (zwischen Prozessen).
+// head = bisher geschriebene Bytes, tail = bisher gelesene Bytes (beide monoton).
+// Der Schreiber veröffentlicht erst nach dem Kopieren (release), der Leser
+// gibt Platz erst nach dem Kopieren frei – keine Locks, keine Systemaufrufe.
+class ShmRing {
+public:
+    struct Header {
+        alignas(64) std::atomic<uint64_t> head{0};
+        alignas(64) std::atomic<uint64_t> tail{0};
+    };
+
+    static size_t footprint(size_t capacity) { return sizeof(Header) + capacity; }
+
+    // mem: footprint(capacity) Bytes; init = true legt den Header neu an (nur einmal, vor fork)
+    void attach(void* mem, size_t capacity, bool init);
+
+    // schreibt/liest höchstens n Bytes, immer ganze Vielfache von `unit`
+    size_t write_some(const void* src, size_t n, size_t unit);
+    size_t read_some(void* dst, size_t n, size_t unit);
+
+    size_t readable() const;
+
+private:
+    Header*  h_ = nullptr;
+    uint8_t* data_ = nullptr;
+    size_t   cap_ = 0;
+};
+
+// Benanntes POSIX-Shared-Memory-Segment (shm_open + mmap)
+class ShmSegment {
+public:
+    ShmSegment() = default;
+    ShmSegment(const ShmSegment&) = delete;
+    ShmSegment& operator=(const ShmSegment&) = delete;
+    ~ShmSegment();
+    void  create(const std::string& name, size_t bytes);   // wirft runtime_error
+    void  unlink();                                         // Name weg, Mapping bleibt
+    void* base() const { return base_; }
+
+private:
+    std::string name_;
+    void*  base_ = nullptr;
+    size_t bytes_ = 0;
+};
@@ -0,0 +1,130 @@
+#include "stimulus.h"
+#include <algorithm>
+#include <functional>
+#include "binary_io.h"
+
+uint32_t StimulusScheduler::alloc(Stimulus s, uint64_t seq) {
+    uint32_t slot;
+    if (!free_.empty()) {
+        slot = free_.back();
+        free_.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(slots_.size());
+        slots_.emplace_back();
+    }
+    slots_[slot].stim = std::move(s);
+    slots_[slot].seq = seq;
+    return slot;
+}
+
+void StimulusScheduler::push(uint32_t slot) {
+    heap_.push_back({ slots_[slot].stim.start, slots_[slot].seq, slot });
+    std::push_heap(heap_.begin(), heap_.end(), std::greater<Key>());
+}
+
+void StimulusScheduler::add(Stimulus s) {
+    if (s.inputs.empty()) return;
+    s.duration = std::max(1, s.duration);
+    s.repeat   = std::max(0, s.repeat);
+    if (s.period < s.duration) s.period = s.duration;   // Durchgänge überlappen nicht
+    push(alloc(std::move(s), next_seq_++));
+}
+
+void StimulusScheduler::clear() {
+    slots_.clear();
+    free_.clear();
+    heap_.clear();
+    active_.clear();
+}
+
+void StimulusScheduler::activate_due(long tick) {
+    while (!heap_.empty() && heap_.front().start <= tick) {
+        std::pop_heap(heap_.begin(), heap_.end(), std::greater<Key>());
+        const uint32_t slot = heap_.back().slot;
+        heap_.pop_back();
+        auto& s = slots_[slot];
+        // zu spät eingeplant: Rest des Fensters, liegt es ganz zurück, einmal jetzt
+        s.end = s.stim.start + s.stim.duration;
+        if (s.end <= tick) s.end = tick + 1;
+        active_.push_back(slot);
+    }
+}
+
+void StimulusScheduler::finish(size_t a) {
+    const uint32_t slot = active_[a];
+    active_[a] = active_.back();
+    active_.pop_back();
+
+    auto& s = slots_[slot];
+    if (s.stim.repeat > 0) {
+        --s.stim.repeat;
+        s.stim.start += s.stim.period;
+        push(slot);
+    } else {
+        s.stim.inputs.clear();
+        free_.push_back(slot);
+    }
+}
+
+namespace {
+
+void put_stim(std::ostream& o, const Stimulus& s) {
+    bio::put_vec(o, s.inputs);
+    bio::put(o, s.amp);
+    bio::put(o, s.start);
+    bio::put(o, s.duration);
+    bio::put(o, s.repeat);
+    bio::put(o, s.period);
+}
+
+void get_stim(std::istream& i, Stimulus& s) {
+    bio::get_vec(i, s.inputs);
+    bio::get(i, s.amp);
+    bio::get(i, s.start);
+    bio::get(i, s.duration);
+    bio::get(i, s.repeat);
+    bio::get(i, s.period);
+}
+
+} // namespace
+
+void StimulusScheduler::save(std::ostream& o) const {
+    bio::put(o, next_seq_);
+    bio::put<uint64_t>(o, active_.size());
+    for (uint32_t slot : active_) {
+        put_stim(o, slots_[slot].stim);
+        bio::put(o, slots_[slot].seq);
+        bio::put(o, slots_[slot].end);
+    }
+    bio::put<uint64_t>(o, heap_.size());
+    for (const Key& k : heap_) {
+        put_stim(o, slots_[k.slot].stim);
+        bio::put(o, slots_[k.slot].seq);
+    }
+}
+
+void StimulusScheduler::load(std::istream& i) {
+    clear();
+    bio::get(i, next_seq_);
+    uint64_t n = 0;
+    bio::get(i, n);
+    for (uint64_t a = 0; a < n; ++a) {
+        Stimulus s;
+        uint64_t seq = 0;
+        long end = 0;
+        get_stim(i, s);
+        bio::get(i, seq);
+        bio::get(i, end);
+        const uint32_t slot = alloc(std::move(s), seq);
+        slots_[slot].end = end;
+        active_.push_back(slot);
+    }
+    bio::get(i, n);
+    for (uint64_t h = 0; h < n; ++h) {
+        Stimulus s;
+        uint64_t seq = 0;
+        get_stim(i, s);
+        bio::get(i, seq);
+        push(alloc(std::move(s), seq));
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <iosfwd>
+
+// Ein geplanter Reiz: dünnes Muster auf der Input-Schicht
+struct Stimulus {
+    std::vector<int> inputs;   // Indizes in input_target (nicht Neuronen-IDs)
+    float amp      = 1.0f;     // Strom pro Tick und Input
+    long  start    = 0;        // erster aktiver Tick (absolut)
+    int   duration = 1;        // aktive Ticks pro Durchgang
+    int   repeat   = 0;        // weitere Durchgänge nach dem ersten
+    int   period   = 0;        // Abstand Start -> Start der Durchgänge (0 = direkt anschließend)
+};
+
+// Tick-geordnete Warteschlange von Reizen (Min-Heap nach Start, bei Gleichstand
+// nach Einfügereihenfolge). Pro Tick werden nur fällige Reize aktiviert und nur
+// die aktiven angewendet: Kosten ~ aktive Inputs, nicht Größe der Input-Schicht.
+class StimulusScheduler {
+public:
+    void add(Stimulus s);
+    void clear();
+
+    // fn(input_index, amp) für jeden aktiven Input in Tick `tick`; Ticks aufsteigend aufrufen
+    template <class F>
+    void apply(long tick, F&& fn) {
+        activate_due(tick);
+        for (size_t a = 0; a < active_.size(); ) {
+            const Slot& s = slots_[active_[a]];
+            for (int i : s.stim.inputs) fn(i, s.stim.amp);
+            if (tick + 1 >= s.end) finish(a);   // tauscht mit dem letzten, a bleibt
+            else ++a;
+        }
+    }
+
+    size_t pending() const { return heap_.size(); }
+    size_t active() const  { return active_.size(); }
+
+    // Checkpoint: aktive Reize in Anwendungsreihenfolge, dann die wartenden
+    void save(std::ostream& o) const;
+    void load(std::istream& i);
+
+private:
+    struct Slot {
+        Stimulus stim;
+        uint64_t seq = 0;     // Einfügereihenfolge (Gleichstand im Heap)
+        long     end = 0;     // aktiv bis exklusiv
+    };
+    struct Key {
+        long start;
+        uint64_t seq;
+        uint32_t slot;
+        bool operator>(const Key& o) const { return start != o.start ? start > o.start : seq > o.seq; }
+    };
+
+    uint32_t alloc(Stimulus s, uint64_t seq);
+    void push(uint32_t slot);
+    void activate_due(long tick);
+    void finish(size_t a);
+
+    std::vector<Slot>     slots_;
+    std::vector<uint32_t> free_;
+    std::vector<Key>      heap_;     // std::push_heap/pop_heap mit greater -> Min-Heap
+    std::vector<uint32_t> active_;
+    uint64_t next_seq_ = 0;
+};
@@ -0,0 +1,72 @@
+#include "net.h"
+#include <cmath>
+
+// Strukturelle Plastizität: abgestorbene Synapsen entfernen, zwischen
+// gleichzeitig aktiven Neuronen neue anlegen. Jede Änderung kostet
+// O(Zeilenlänge) im SynapseStore, ein Tick wird nie komplett neu gebaut;
+// auch das Aufräumen läuft in begrenzten Stücken (compact_slots pro Schritt).
+void Net::structural_step() {
+    const int N = neu.N;
+    const long before = n_pruned + n_grown;
+
+    // 1️⃣ Pruning: rotierendes Fenster über die Pre-Zeilen (nur plastischer Store)
+    const int rows = std::min(prune_rows, N);
+    for (int r = 0; r < rows; ++r) {
+        const int pre = prune_cursor;
+        prune_cursor = (prune_cursor + 1) % N;
+
+        for (int k = syn.row_begin(pre); k < syn.row_end(pre); ) {
+            const float w = syn.weight(k);
+            if (w <= wmin + prune_eps) {
+                syn.remove(pre, k);   // letzte Synapse rückt nach k -> k nicht erhöhen
+                ++n_pruned;
+            } else {
+                ++k;
+            }
+        }
+    }
+
+    // 2️⃣ Kandidaten fürs Wachstum: gleichverteilt aus den Spikes dieses Ticks (Reservoir),
+    //    aufgefüllt mit Stichproben kürzlich aktiver Neuronen (hoher post-Trace).
+    //    Kosten O(Spikes + 64) statt O(N), und keine Bevorzugung kleiner IDs
+    constexpr size_t kCandidates = 64;
+    std::vector<int> active;
+    size_t seen = 0;
+    for (int i : neu.spikes) {
+        if (active.size() < kCandidates) active.push_back(i);
+        else if (const size_t j = rng() % (seen + 1); j < kCandidates) active[j] = i;
+        ++seen;
+    }
+    const float dq = std::exp(-neu.dt / tau_post);
+    for (size_t probe = 0; probe < kCandidates && active.size() < kCandidates; ++probe) {
+        const int i = static_cast<int>(rng() % N);
+        float tr = post_trace[i];
+        if (!trace_tick.empty() && tick > trace_tick[i])   // Event-Modus: lazy Zerfall
+            tr *= std::pow(dq, static_cast<float>(tick - trace_tick[i]));
+        if (tr >= coactive_trace) active.push_back(i);
+    }
+
+    // 3️⃣ Wachstum zwischen Paaren aktiver Neuronen (nur erregende Sender)
+    if (active.size() >= 2) {
+        for (int g = 0; g < grow_max; ++g) {
+            const int pre  = active[rng() % active.size()];
+            const int post = active[rng() % active.size()];
+            if (pre == post || is_output[pre] || is_input[pre] || is_input[post]) continue;
+            if (role_of(pre) == PopRole::Inhibitory) continue;
+            if (syn.find(pre, post) >= 0 || syn_static.find(pre, post) >= 0) continue;
+
+            syn.add(pre, post, grow_w, grow_delay, true);
+            ++n_grown;
+        }
+    }
+
+    // 4️⃣ Müll aus Zeilen-Umzügen einsammeln: höchstens compact_slots Slots pro Schritt nach
+    //    vorn schieben, ein Durchgang verteilt sich über mehrere Schritte
+    const bool compacted = syn.compacting() || syn.needs_compaction();
+    if (compacted && syn.compact_step(static_cast<size_t>(std::max(1, compact_slots)), row_slack))
+        ++n_compactions;
+
+    // 5️⃣ Eligibility hängt an Store-Positionen: nach jeder Änderung neu zuordnen
+    if (plasticity == Plasticity::Reward && (compacted || n_pruned + n_grown != before))
+        for (auto& el : elig) el.remap(syn);
+}
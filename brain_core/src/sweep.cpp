@@ -0,0 +1,297 @@
+#include "sweep.h"
+#include "net.h"
+#include "network_builder.h"
+#include "counter_rng.h"
+#include <nlohmann/json.hpp>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <memory>
+
+using json = nlohmann::json;
+
+namespace {
+
+// alle Hormone mit Namen (für base_config-Parameter und Kennzahlen)
+const std::pair<const char*, float HormoneSet::*> kHormones[] = {
+    {"dopamine", &HormoneSet::dopamine},           {"serotonin", &HormoneSet::serotonin},
+    {"cortisol", &HormoneSet::cortisol},           {"adrenaline", &HormoneSet::adrenaline},
+    {"oxytocin", &HormoneSet::oxytocin},           {"melatonin", &HormoneSet::melatonin},
+    {"noradrenaline", &HormoneSet::noradrenaline}, {"endorphin", &HormoneSet::endorphin},
+    {"acetylcholine", &HormoneSet::acetylcholine}, {"testosterone", &HormoneSet::testosterone},
+};
+
+// Ein Sweep-Parameter: feste Werteliste oder Bereich (nur Zufallssuche)
+struct Axis {
+    std::string name;
+    std::vector<double> values;
+    double lo = 0.0, hi = 0.0;
+    bool   log = false;
+};
+
+struct SweepSpec {
+    long steps = 5000;
+    int  threads = 0;
+    bool random = false;
+    int  samples = 16;
+    uint64_t seed = 1;
+    std::string net;          // leer = Demo-Netz
+    Engine engine = Engine::Clock;
+    std::string out = "sweep_results.csv";
+    std::vector<Axis> axes;
+};
+
+using Point = std::vector<std::pair<std::string, double>>;
+
+SweepSpec parse_sweep(const json& j) {
+    SweepSpec s;
+    s.steps   = j.value("steps", s.steps);
+    s.threads = j.value("threads", s.threads);
+    s.random  = j.value("mode", std::string("grid")) == "random";
+    s.samples = j.value("samples", s.samples);
+    s.seed    = j.value("seed", s.seed);
+    s.net     = j.value("net", s.net);
+    s.out     = j.value("out", s.out);
+    if (j.value("engine", std::string("clock")) == "event") s.engine = Engine::Event;
+
+    for (const auto& [name, v] : j.at("params").items()) {
+        Axis a;
+        a.name = name;
+        if (v.is_array()) {
+            for (const auto& x : v) a.values.push_back(x.get<double>());
+        } else if (v.is_object()) {
+            if (!s.random) throw std::runtime_error("Bereich nur bei mode=random: " + name);
+            a.lo  = v.at("min").get<double>();
+            a.hi  = v.at("max").get<double>();
+            a.log = v.value("log", false);
+            if (a.log && (a.lo <= 0.0 || a.hi <= 0.0))
+                throw std::runtime_error("log-Bereich braucht min, max > 0: " + name);
+        } else {
+            a.values.push_back(v.get<double>());
+        }
+        s.axes.push_back(std::move(a));
+    }
+    return s;
+}
+
+// Gitter = kartesisches Produkt, Zufall = samples Punkte (deterministisch aus seed)
+std::vector<Point> make_points(const SweepSpec& s) {
+    std::vector<Point> pts;
+    if (!s.random) {
+        pts.emplace_back();
+        for (const auto& a : s.axes) {
+            std::vector<Point> next;
+            for (const auto& p : pts)
+                for (double v : a.values) {
+                    Point q = p;
+                    q.emplace_back(a.name, v);
+                    next.push_back(std::move(q));
+                }
+            pts = std::move(next);
+        }
+        return pts;
+    }
+    for (int i = 0; i < s.samples; ++i) {
+        CounterRng r(s.seed, 0, static_cast<uint64_t>(i), 0);
+        Point p;
+        for (const auto& a : s.axes) {
+            double v;
+            if (!a.values.empty()) v = a.values[r.below(static_cast<uint32_t>(a.values.size()))];
+            else if (a.log)        v = std::exp(std::log(a.lo) + (std::log(a.hi) - std::log(a.lo)) * r.uniform());
+            else                   v = a.lo + (a.hi - a.lo) * r.uniform();
+            p.emplace_back(a.name, v);
+        }
+        pts.push_back(std::move(p));
+    }
+    return pts;
+}
+
+// Parameter vor dem Aufbau setzen (init_runtime rechnet z.B. hop_gain daraus)
+void set_param(Net& net, const std::string& name, double v) {
+    const float f = static_cast<float>(v);
+    if      (name == "learning_rate")         net.learning_rate = f;
+    else if (name == "Aplus")                 net.Aplus = f;
+    else if (name == "Aminus")                net.Aminus = f;
+    else if (name == "tau_pre")               net.tau_pre = f;
+    else if (name == "tau_post")              net.tau_post = f;
+    else if (name == "wmin")                  net.wmin = f;
+    else if (name == "wmax")                  net.wmax = f;
+    else if (name == "spike_decay_per_hop")   net.spike_decay_per_hop = f;
+    else if (name == "max_propagation_depth") net.max_propagation_depth = static_cast<int>(v);
+    else if (name.rfind("hormone.", 0) == 0) {
+        const std::string h = name.substr(8);
+        for (const auto& [hn, field] : kHormones) {
+            if (h == hn) {
+                net.H.base_config.*field = f;
+                net.H.current = net.H.target = net.H.base_config;
+                return;
+            }
+        }
+        throw std::runtime_error("Unbekanntes Hormon: " + h);
+    }
+    else throw std::runtime_error("Unbekannter Sweep-Parameter: " + name);
+}
+
+struct Metrics {
+    double rate_hz = 0.0;                 // alle Neuronen
+    std::vector<double> pop_rate_hz;      // pro Population
+    double w_mean = 0.0, w_std = 0.0, w_min = 0.0, w_max = 0.0;
+    double frac_wmin = 0.0, frac_wmax = 0.0;
+    double h_mean[10] = {}, h_final[10] = {};
+    double vth_shift = 0.0;
+    double wall_ms = 0.0;
+    std::string error;
+};
+
+Metrics run_one(const SweepSpec& s, const NetSpec* net_spec, const Point& p) {
+    Metrics m;
+    const auto t0 = std::chrono::steady_clock::now();
+    try {
+        Net net;
+        net.engine = s.engine;
+        for (const auto& [name, v] : p) set_param(net, name, v);
+        if (net_spec) {
+            // Sweep-Werte haben Vorrang vor den params der Netz-Spec
+            NetSpec local = *net_spec;
+            for (const auto& kv : p) local.params.erase(kv.first);
+            net.build_from_spec(local);
+        } else {
+            net.build_small_demo(50, 30, 10, 10);
+        }
+
+        std::vector<long> pop_spikes(net.pops.size(), 0);
+        long total = 0;
+        for (long t = 0; t < s.steps; ++t) {
+            net.step_once(0.0f);
+            net.readout.decoded.clear();
+            size_t q = 0;   // Spikes und Populationen aufsteigend
+            for (int i : net.neu.spikes) {
+                while (i >= net.pops[q].end) ++q;
+                ++pop_spikes[q];
+            }
+            total += static_cast<long>(net.neu.spikes.size());
+            for (int h = 0; h < 10; ++h) m.h_mean[h] += net.H.current.*kHormones[h].second;
+        }
+
+        const double T = s.steps * net.neu.dt;
+        m.rate_hz = T > 0 ? total / (T * net.neu.N) : 0.0;
+        for (size_t q = 0; q < net.pops.size(); ++q)
+            m.pop_rate_hz.push_back(T > 0 ? pop_spikes[q] / (T * std::max(1, net.pops[q].size())) : 0.0);
+        for (int h = 0; h < 10; ++h) {
+            m.h_mean[h] /= std::max(1L, s.steps);
+            m.h_final[h] = net.H.current.*kHormones[h].second;
+        }
+        m.vth_shift = net.neu.vth_shift;
+
+        // Gewichtsverteilung der plastischen, erregenden Synapsen
+        double sum = 0.0, sum2 = 0.0;
+        long n = 0, at_min = 0, at_max = 0;
+        m.w_min = 1e9; m.w_max = -1e9;
+        for (int pre = 0; pre < net.neu.N; ++pre) {
+            for (int k = net.syn.row_begin(pre); k < net.syn.row_end(pre); ++k) {
+                const double w = net.syn.weight(k);
+                sum += w; sum2 += w * w; ++n;
+                m.w_min = std::min(m.w_min, w);
+                m.w_max = std::max(m.w_max, w);
+                if (w <= net.wmin + 1e-6) ++at_min;
+                if (w >= net.wmax - 1e-6) ++at_max;
+            }
+        }
+        if (n > 0) {
+            m.w_mean = sum / n;
+            m.w_std  = std::sqrt(std::max(0.0, sum2 / n - m.w_mean * m.w_mean));
+            m.frac_wmin = static_cast<double>(at_min) / n;
+            m.frac_wmax = static_cast<double>(at_max) / n;
+        } else {
+            m.w_min = m.w_max = 0.0;
+        }
+    } catch (const std::exception& e) {
+        m.error = e.what();
+    }
+    m.wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    return m;
+}
+
+} // namespace
+
+int run_sweep(const std::string& spec_path) {
+    SweepSpec s;
+    std::unique_ptr<NetSpec> net_spec;
+    try {
+        std::ifstream f(spec_path);
+        if (!f) throw std::runtime_error("Sweep-Spec nicht gefunden: " + spec_path);
+        s = parse_sweep(json::parse(f));
+        Net check;   // unbekannte Parameter vor dem Start melden, nicht pro Lauf
+        for (const auto& a : s.axes) set_param(check, a.name, a.values.empty() ? a.lo : a.values.front());
+        if (!s.net.empty()) {
+            net_spec = std::make_unique<NetSpec>(load_net_spec(s.net));
+            net_spec->threads = 1;   // parallel wird über die Läufe, nicht im Aufbau
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Sweep: " << e.what() << "\n";
+        return 1;
+    }
+
+    const auto points = make_points(s);
+    const int threads = s.threads > 0 ? s.threads : std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "🔬 Sweep: " << points.size() << " Läufe × " << s.steps << " Schritte auf "
+              << threads << " Threads\n";
+
+    // 1️⃣ Läufe über einen gemeinsamen Zähler verteilen (lange und kurze Läufe mischen sich)
+    std::vector<Metrics> results(points.size());
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> done{0};
+    const auto t0 = std::chrono::steady_clock::now();
+    auto worker = [&] {
+        for (size_t i = next++; i < points.size(); i = next++) {
+            results[i] = run_one(s, net_spec.get(), points[i]);
+            ++done;
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) pool.emplace_back(worker);
+    for (auto& t : pool) t.join();
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    // 2️⃣ Ergebnistabelle
+    std::ofstream out(s.out, std::ios::trunc);
+    if (!out) {
+        std::cerr << "❌ Sweep: kann " << s.out << " nicht schreiben\n";
+        return 1;
+    }
+    out << "run";
+    for (const auto& a : s.axes) out << "," << a.name;
+    out << ",rate_hz";
+    std::vector<std::string> pop_names = { "input", "hidden", "output" };   // Demo-Netz
+    if (net_spec) {
+        pop_names.clear();
+        for (const auto& p : net_spec->populations) pop_names.push_back(p.name);
+    }
+    for (const auto& n : pop_names) out << ",rate_" << n << "_hz";
+    out << ",w_mean,w_std,w_min,w_max,frac_wmin,frac_wmax,vth_shift";
+    for (const auto& h : kHormones) out << "," << h.first << "_mean," << h.first << "_final";
+    out << ",wall_ms,error\n";
+
+    out << std::setprecision(6);
+    for (size_t i = 0; i < points.size(); ++i) {
+        const Metrics& m = results[i];
+        out << i;
+        for (const auto& kv : points[i]) out << "," << kv.second;
+        out << "," << m.rate_hz;
+        for (size_t q = 0; q < pop_names.size(); ++q)
+            out << "," << (q < m.pop_rate_hz.size() ? m.pop_rate_hz[q] : 0.0);
+        out << "," << m.w_mean << "," << m.w_std << "," << m.w_min << "," << m.w_max
+            << "," << m.frac_wmin << "," << m.frac_wmax << "," << m.vth_shift;
+        for (int h = 0; h < 10; ++h) out << "," << m.h_mean[h] << "," << m.h_final[h];
+        out << "," << m.wall_ms << ",\"" << m.error << "\"\n";
+    }
+
+    std::cout << "✅ " << done << " Läufe in " << std::fixed << std::setprecision(1) << wall
+              << " s -> " << s.out << "\n";
+    return 0;
+}
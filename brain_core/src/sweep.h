@@ -0,0 +1,8 @@
+#pragma once
+#include <string>
+
+// Parameter-Sweep: viele Netze parallel (ein Lauf pro Job, alle Kerne), ohne
+// Echtzeit-Takt und ohne Datei-I/O während der Läufe. Am Ende eine CSV-Tabelle
+// mit Kennzahlen pro Lauf (Feuerraten, Gewichtsverteilung, Hormonverlauf).
+// Beispiel-Spec: config/sweep_example.json
+int run_sweep(const std::string& spec_path);
@@ -0,0 +1,297 @@
+#include "synapse_store.h"
+#include <stdexcept>
+
+namespace {
+
+// Slots [k0, k1) der Zeilen [b, e) pro Bereich von run; Zeilen liegen dicht hintereinander,
+// die Reserve einer Zeile gehört zu ihrem Bereich
+void for_row_slots(const RowSpans& rows, size_t slots, const RowRunner& run,
+                   const std::function<void(int, int, size_t, size_t)>& fn) {
+    const auto span = [&](int b, int e) {
+        if (b >= e) return;
+        fn(b, e, rows.start[b], e < rows.rows() ? rows.start[e] : slots);
+    };
+    if (run) run(span);
+    else     span(0, rows.rows());
+}
+
+} // namespace
+
+void RowSpans::set_dense(const std::vector<int>& offsets) {
+    const int n = static_cast<int>(offsets.size()) - 1;
+    start.resize(n); len.resize(n); cap.resize(n);
+    for (int r = 0; r < n; ++r) {
+        start[r] = static_cast<uint32_t>(offsets[r]);
+        len[r] = cap[r] = static_cast<uint32_t>(offsets[r + 1] - offsets[r]);
+    }
+    used = live = static_cast<size_t>(offsets[n]);
+    garbage = 0;
+    by_start.clear();   // ohne Reserve wächst nichts; compact_step stellt die Reihenfolge bei Bedarf her
+    compacting = false;
+}
+
+void RowSpans::layout(const std::vector<uint32_t>& lens, float slack) {
+    const int n = static_cast<int>(lens.size());
+    start.resize(n); len = lens; cap.resize(n);
+    size_t pos = 0;
+    live = 0;
+    by_start.clear();
+    for (int r = 0; r < n; ++r) {
+        start[r] = static_cast<uint32_t>(pos);
+        cap[r]   = lens[r] + reserve_for(lens[r], slack);
+        pos  += cap[r];
+        live += lens[r];
+        if (slack > 0.0f) by_start.push_back({ r, start[r] });
+    }
+    used = pos;
+    garbage = 0;
+    compacting = false;
+}
+
+void RowSpans::relocate(int r, uint32_t new_cap) {
+    garbage += cap[r];
+    start[r] = static_cast<uint32_t>(used);
+    cap[r]   = new_cap;
+    used    += new_cap;
+    if (!by_start.empty()) by_start.push_back({ r, start[r] });
+}
+
+void SynapseStore::build(int n_pre, std::vector<Synapse>& edges, WeightFormat f, float w_abs_max,
+                         const RowRunner& run) {
+    // 1️⃣ Counting-Sort nach pre (kein globaler Vergleichs-Sort nötig)
+    std::vector<int> pre_offsets(n_pre + 1, 0);
+    for (const auto& e : edges) pre_offsets[e.pre + 1]++;
+    for (int i = 1; i <= n_pre; ++i) pre_offsets[i] += pre_offsets[i - 1];
+
+    std::vector<int> order(edges.size());
+    {
+        std::vector<int> cursor(pre_offsets.begin(), pre_offsets.end() - 1);
+        for (size_t i = 0; i < edges.size(); ++i)
+            order[cursor[edges[i].pre]++] = static_cast<int>(i);
+    }
+
+    // innerhalb einer Zeile nach post sortieren (kleine, lokale Sorts)
+    for (int pre = 0; pre < n_pre; ++pre) {
+        std::stable_sort(order.begin() + pre_offsets[pre], order.begin() + pre_offsets[pre + 1],
+                         [&](int a, int b) { return edges[a].post < edges[b].post; });
+    }
+
+    // 2️⃣ Packen: jeder Zeilenbereich schreibt seine Slots selbst (First Touch)
+    for (const auto& e : edges)
+        if (static_cast<uint32_t>(e.post) > kPostMask)
+            throw std::runtime_error("SynapseStore: post-ID passt nicht in 24 Bit");
+    const size_t S = edges.size();
+    cols = {};   // ein alter CSC-Index passt nicht mehr, build_post_index legt ihn neu an
+    in_pre.clear(); in_syn.clear(); csc_pos.clear();
+    target.clear();
+    target.resize(S);
+    std::vector<float> w(S);
+    rows.set_dense(pre_offsets);
+    for_row_slots(rows, S, run, [&](int, int, size_t k0, size_t k1) {
+        for (size_t k = k0; k < k1; ++k) {
+            const auto& e = edges[order[k]];
+            target[k] = pack_target(e.post, e.delay, e.plastic);
+            w[k] = e.w;
+        }
+    });
+    pack_weights(w, f, w_abs_max, run);
+}
+
+void SynapseStore::pack_weights(const std::vector<float>& w, WeightFormat f, float w_abs_max,
+                                const RowRunner& run) {
+    fmt = f;
+    const size_t S = w.size();
+    w32.clear(); w16.clear(); w8.clear(); block_scale.clear();
+    scale_bound = w_abs_max;
+    for (float x : w) scale_bound = std::max(scale_bound, std::fabs(x));
+
+    switch (fmt) {
+        case WeightFormat::F16: w16.resize(S); break;
+        case WeightFormat::I8:
+            w8.resize(S);
+            block_scale.assign((S >> kBlockShift) + 1, 0.0f);
+            for (size_t k = 0; k < S; ++k) {
+                float& s = block_scale[k >> kBlockShift];
+                s = std::max(s, std::max(std::fabs(w[k]), w_abs_max) / 127.0f);
+            }
+            break;
+        default: w32.resize(S); break;
+    }
+
+    for_row_slots(rows, S, run, [&](int, int, size_t k0, size_t k1) {
+        for (size_t k = k0; k < k1; ++k) set_weight(k, w[k]);
+    });
+}
+
+void SynapseStore::build_post_index(int n_post, float slack) {
+    const int n_pre = rows.rows();
+    std::vector<uint32_t> lens(n_post, 0);
+    for (int pre = 0; pre < n_pre; ++pre)
+        for (int k = row_begin(pre); k < row_end(pre); ++k) lens[post(k)]++;
+    cols.layout(lens, slack);
+
+    in_pre.assign(cols.used, 0);
+    in_syn.assign(cols.used, 0);
+    csc_pos.assign(target.size(), 0);
+    std::vector<uint32_t> fill(n_post, 0);
+    for (int pre = 0; pre < n_pre; ++pre) {
+        for (int k = row_begin(pre); k < row_end(pre); ++k) {
+            const int p = post(k);
+            const uint32_t c = cols.start[p] + fill[p]++;
+            in_pre[c] = pre;
+            in_syn[c] = static_cast<uint32_t>(k);
+            csc_pos[k] = c;
+        }
+    }
+}
+
+int SynapseStore::find(int pre, int post_id) const {
+    for (int k = row_begin(pre); k < row_end(pre); ++k)
+        if (post(k) == post_id) return k;
+    return -1;
+}
+
+size_t SynapseStore::add(int pre, int post_id, float w, int delay, bool plastic_flag) {
+    if (static_cast<uint32_t>(post_id) > kPostMask)
+        throw std::runtime_error("SynapseStore: post-ID passt nicht in 24 Bit");
+
+    // Zeile voll -> ans Ende umziehen, +50 % Reserve
+    if (rows.full(pre)) {
+        const uint32_t old = rows.start[pre], n = rows.len[pre];
+        rows.relocate(pre, n + std::max<uint32_t>(4, n / 2));
+        resize_slots(rows.used);
+        for (uint32_t i = 0; i < n; ++i) move_slot(old + i, rows.start[pre] + i);
+    }
+
+    const uint32_t k = rows.start[pre] + rows.len[pre]++;
+    ++rows.live;
+    target[k] = pack_target(post_id, delay, plastic_flag);
+    set_weight(k, w);
+    if (has_post_index()) csc_add(post_id, pre, k);
+    return k;
+}
+
+void SynapseStore::remove(int pre, size_t k) {
+    if (has_post_index()) csc_remove(post(k), csc_pos[k]);
+    const size_t last = static_cast<size_t>(row_end(pre)) - 1;
+    if (k != last) move_slot(last, k);
+    --rows.len[pre];
+    --rows.live;
+}
+
+bool SynapseStore::needs_compaction() const {
+    return rows.garbage * 2 > rows.used || cols.garbage * 2 > cols.used;
+}
+
+void SynapseStore::compact(float slack, const RowRunner& run) {
+    const RowSpans old = rows;
+    rows.layout(old.len, slack);
+
+    // Reserve-Slots mit 0 füllen: Checkpoint und State-Hash sehen die rohen Arrays
+    pvector<uint32_t>  t(rows.used);
+    std::vector<float> w(rows.used, 0.0f);
+    for_row_slots(rows, rows.used, run, [&](int b, int e, size_t, size_t) {
+        for (int r = b; r < e; ++r) {
+            for (uint32_t i = 0; i < rows.len[r]; ++i) {
+                t[rows.start[r] + i] = target[old.start[r] + i];
+                w[rows.start[r] + i] = weight(old.start[r] + i);
+            }
+            std::fill(t.begin() + rows.start[r] + rows.len[r], t.begin() + rows.start[r] + rows.cap[r], 0u);
+        }
+    });
+    target = std::move(t);
+    pack_weights(w, fmt, scale_bound, run);
+
+    if (has_post_index()) build_post_index(cols.rows(), slack);
+}
+
+bool SynapseStore::compact_step(size_t max_slots, float slack) {
+    // 1️⃣ Zeilen: Payload und CSC-Rückverweise ziehen mit
+    if (rows.compacting || rows.garbage * 2 > rows.used) {
+        if (!rows.compact_step(max_slots, slack, [&](uint32_t from, uint32_t to) { move_slot(from, to); }))
+            return false;
+        resize_slots(rows.used);
+        return true;
+    }
+    // 2️⃣ CSC-Spalten: in_pre/in_syn ziehen um, csc_pos zeigt auf die neue Stelle
+    if (has_post_index() && (cols.compacting || cols.garbage * 2 > cols.used)) {
+        const bool done = cols.compact_step(max_slots, slack, [&](uint32_t from, uint32_t to) {
+            in_pre[to] = in_pre[from];
+            in_syn[to] = in_syn[from];
+            csc_pos[in_syn[to]] = to;
+        });
+        if (!done) return false;
+        in_pre.resize(cols.used);
+        in_syn.resize(cols.used);
+        return true;
+    }
+    return false;
+}
+
+void SynapseStore::resize_slots(size_t n) {
+    target.resize(n, 0);
+    switch (fmt) {
+        case WeightFormat::F16: w16.resize(n, 0); break;
+        case WeightFormat::I8:
+            w8.resize(n, 0);
+            block_scale.resize((n >> kBlockShift) + 1, scale_bound / 127.0f);
+            break;
+        default: w32.resize(n, 0.0f); break;
+    }
+    if (has_post_index()) csc_pos.resize(n, 0);
+}
+
+void SynapseStore::move_slot(size_t from, size_t to) {
+    target[to] = target[from];
+    set_weight(to, weight(from));
+    if (has_post_index()) {
+        csc_pos[to] = csc_pos[from];
+        in_syn[csc_pos[to]] = static_cast<uint32_t>(to);
+    }
+}
+
+void SynapseStore::csc_add(int post_id, int pre, uint32_t k) {
+    if (cols.full(post_id)) {
+        const uint32_t old = cols.start[post_id], n = cols.len[post_id];
+        cols.relocate(post_id, n + std::max<uint32_t>(4, n / 2));
+        in_pre.resize(cols.used, 0);
+        in_syn.resize(cols.used, 0);
+        for (uint32_t i = 0; i < n; ++i) {
+            const uint32_t c = cols.start[post_id] + i;
+            in_pre[c] = in_pre[old + i];
+            in_syn[c] = in_syn[old + i];
+            csc_pos[in_syn[c]] = c;
+        }
+    }
+    const uint32_t c = cols.start[post_id] + cols.len[post_id]++;
+    ++cols.live;
+    in_pre[c]  = pre;
+    in_syn[c]  = k;
+    csc_pos[k] = c;
+}
+
+void SynapseStore::csc_remove(int post_id, uint32_t c) {
+    const uint32_t last = cols.start[post_id] + cols.len[post_id] - 1;
+    if (c != last) {
+        in_pre[c] = in_pre[last];
+        in_syn[c] = in_syn[last];
+        csc_pos[in_syn[c]] = c;
+    }
+    --cols.len[post_id];
+    --cols.live;
+}
+
+size_t SynapseStore::bytes_per_synapse() const {
+    switch (fmt) {
+        case WeightFormat::F16: return sizeof(uint32_t) + sizeof(uint16_t);
+        case WeightFormat::I8:  return sizeof(uint32_t) + sizeof(int8_t);
+        default:                return sizeof(uint32_t) + sizeof(float);
+    }
+}
+
+WeightFormat parse_weight_format(const std::string& s) {
+    if (s == "f16") return WeightFormat::F16;
+    if (s == "i8")  return WeightFormat::I8;
+    if (s == "f32") return WeightFormat::F32;
+    throw std::runtime_error("Unbekanntes Gewichtsformat: " + s);
+}
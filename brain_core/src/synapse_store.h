@@ -0,0 +1,282 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <string>
+#include <functional>
+#include "placement.h"
+
+// einfache Synapse (nur beim Aufbau, danach liegt alles im SynapseStore)
+struct Synapse {
+    int   pre;
+    int   post;
+    float w;
+    uint16_t delay; // in "Ticks" (dt-Schritten)
+    bool  plastic = true;  // false: Gewicht bleibt fest (kein STDP)
+};
+
+// lernt die Synapse? Inhibitorische Gewichte bleiben immer fest
+inline bool learns(bool plastic, float w) { return plastic && w >= 0.0f; }
+
+// Speicherformat der Gewichte
+enum class WeightFormat : uint8_t {
+    F32,  // 4 Byte, exakt (Default, nötig für feine STDP-Schritte)
+    F16,  // 2 Byte, IEEE half
+    I8    // 1 Byte, int8 mit Skala pro Block
+};
+
+// --- half <-> float (ohne F16C, Round-to-nearest-even) ---
+inline uint16_t float_to_half(float f) {
+    uint32_t x;
+    std::memcpy(&x, &f, 4);
+    const uint32_t sign = (x >> 16) & 0x8000u;
+    const uint32_t absx = x & 0x7FFFFFFFu;
+
+    if (absx >= 0x7F800000u)                           // Inf / NaN
+        return static_cast<uint16_t>(sign | 0x7C00u | (absx > 0x7F800000u ? 0x200u : 0u));
+    if (absx >= 0x477FF000u)                           // zu groß -> Inf
+        return static_cast<uint16_t>(sign | 0x7C00u);
+    if (absx < 0x38800000u) {                          // subnormal / 0
+        if (absx < 0x33000000u) return static_cast<uint16_t>(sign);
+        const uint32_t mant  = (absx & 0x007FFFFFu) | 0x00800000u;
+        const int      shift = 126 - static_cast<int>(absx >> 23);
+        uint32_t h = mant >> shift;
+        const uint32_t rem  = mant & ((1u << shift) - 1);
+        const uint32_t half = 1u << (shift - 1);
+        if (rem > half || (rem == half && (h & 1u))) ++h;
+        return static_cast<uint16_t>(sign | h);
+    }
+    uint32_t h = ((absx - 0x38000000u) >> 13);
+    const uint32_t rem = absx & 0x1FFFu;
+    if (rem > 0x1000u || (rem == 0x1000u && (h & 1u))) ++h;
+    return static_cast<uint16_t>(sign | h);
+}
+
+inline float half_to_float(uint16_t h) {
+    const uint32_t sign = static_cast<uint32_t>(h & 0x8000u) << 16;
+    const uint32_t exp  = (h >> 10) & 0x1Fu;
+    const uint32_t mant = h & 0x3FFu;
+    uint32_t x;
+    if (exp == 0) {
+        if (mant == 0) {
+            x = sign;
+        } else {                                       // subnormal normalisieren
+            int e = -1;
+            uint32_t m = mant;
+            do { ++e; m <<= 1; } while ((m & 0x400u) == 0);
+            x = sign | ((112u - e) << 23) | ((m & 0x3FFu) << 13);
+        }
+    } else if (exp == 0x1F) {
+        x = sign | 0x7F800000u | (mant << 13);
+    } else {
+        x = sign | ((exp + 112u) << 23) | (mant << 13);
+    }
+    float f;
+    std::memcpy(&f, &x, 4);
+    return f;
+}
+
+// Zeilen mit Reserve-Slots: Zeile r belegt [start, start + len), Platz bis start + cap.
+// Ist eine Zeile voll, zieht sie ans Ende der Arrays um (wie vector-Wachstum);
+// der alte Bereich wird zu Müll, den compact_step() schrittweise einsammelt.
+struct RowSpans {
+    struct Ref {
+        int32_t  row;
+        uint32_t start;   // start der Zeile beim Eintragen; passt er nicht mehr, ist sie umgezogen
+    };
+
+    std::vector<uint32_t> start, len, cap;
+    size_t used    = 0;   // belegte Länge der Payload-Arrays (inkl. Reserve und Müll)
+    size_t live    = 0;   // Summe len
+    size_t garbage = 0;   // Slots in verlassenen Bereichen (= used - Summe cap)
+
+    // Zeilen nach start aufsteigend, Umzüge hängen hinten an (nur mit Reserve, s. layout)
+    std::vector<Ref> by_start;
+    // laufende Kompaktierung: Einträge vor `cursor` liegen dicht vor `write`
+    bool   compacting = false;
+    size_t cursor = 0, write = 0;
+    std::vector<Ref> packed;   // by_start des neuen Layouts
+
+    // dicht, ohne Reserve (offsets: n+1 Einträge)
+    void set_dense(const std::vector<int>& offsets);
+    // dicht mit Reserve pro Zeile (slack = Anteil von len, mind. 2 Slots)
+    void layout(const std::vector<uint32_t>& lens, float slack);
+    // neuer Bereich mit Kapazität new_cap am Ende; alter Bereich -> Müll
+    void relocate(int r, uint32_t new_cap);
+
+    // Schiebt Zeilen in start-Reihenfolge an den Anfang, bis etwa max_slots Slots bewegt sind;
+    // move(from, to) zieht einen Payload-Slot um (to <= from). Dazwischen bleibt jede Zeile
+    // gültig. true, sobald alles dicht liegt (used ist dann kleiner, der Rest kann weg)
+    template <class Move> bool compact_step(size_t max_slots, float slack, Move&& move);
+
+    static uint32_t reserve_for(uint32_t n, float slack) {
+        return slack > 0.0f ? std::max<uint32_t>(2, static_cast<uint32_t>(std::ceil(n * slack))) : 0u;
+    }
+    int  rows() const { return static_cast<int>(start.size()); }
+    bool full(int r) const { return len[r] == cap[r]; }
+};
+
+template <class Move>
+bool RowSpans::compact_step(size_t max_slots, float slack, Move&& move) {
+    if (!compacting) {
+        if (by_start.empty()) {
+            // ohne Reserve angelegt: Reihenfolge einmal herstellen, ab jetzt mitführen
+            for (int r = 0; r < rows(); ++r) by_start.push_back({ r, start[r] });
+            std::stable_sort(by_start.begin(), by_start.end(),
+                             [](const Ref& a, const Ref& b) { return a.start < b.start; });
+        }
+        compacting = true;
+        cursor = write = 0;
+        packed.reserve(start.size());
+    }
+
+    size_t work = 0;
+    while (cursor < by_start.size()) {
+        if (work >= max_slots) return false;
+        const Ref e = by_start[cursor++];
+        ++work;
+        if (start[e.row] != e.start) continue;   // seitdem umgezogen, der neue Eintrag kommt noch
+
+        // [write, e.start) ist frei: alles davor ist schon gepackt oder umgezogen
+        const int r = e.row;
+        const uint32_t n = len[r];
+        const uint32_t c = std::min<uint32_t>(n + reserve_for(n, slack), e.start + cap[r] - static_cast<uint32_t>(write));
+        if (e.start != write)
+            for (uint32_t i = 0; i < n; ++i) move(e.start + i, static_cast<uint32_t>(write) + i);
+        garbage = garbage + cap[r] - c;
+        start[r] = static_cast<uint32_t>(write);
+        cap[r]   = c;
+        packed.push_back({ r, start[r] });
+        write += c;
+        work  += n;
+    }
+
+    // alle Zeilen liegen dicht vor write, dahinter nur Müll
+    garbage -= used - write;
+    used = write;
+    by_start.swap(packed);
+    std::vector<Ref>().swap(packed);
+    compacting = false;
+    return true;
+}
+
+// Ruft fn(row_begin, row_end) für Zeilenbereiche auf, die zusammen alle Zeilen abdecken,
+// z.B. Net::for_partitions: wer einen Bereich zuerst beschreibt, bekommt seine Seiten
+// (First Touch). Leer = ein Bereich auf dem aufrufenden Thread
+using RowRunner = std::function<void(const std::function<void(int, int)>&)>;
+
+// Kompakter Synapsenspeicher (CSR nach Pre-Neuron)
+//  - pre ist implizit durch die Zeile (rows)
+//  - post (24 Bit), plastic-Flag (1 Bit) und delay (7 Bit) teilen sich ein 32-Bit-Wort
+//  - Gewichte als f32, f16 oder int8 + Skala pro Block
+// => 8 / 6 / 5 Byte pro Synapse statt 16 (Synapse) + 4 (syn_by_pre) + 8 (Traces)
+class SynapseStore {
+public:
+    static constexpr int      kPostBits   = 24;
+    static constexpr uint32_t kPostMask   = (1u << kPostBits) - 1;    // max ~16.7 Mio Neuronen
+    static constexpr uint32_t kPlasticBit = 1u << kPostBits;
+    static constexpr int      kDelayShift = kPostBits + 1;
+    static constexpr int      kMaxDelay   = 0x7F;                     // 127 Ticks
+    static constexpr int      kBlockShift = 6;                        // 64 Synapsen pro I8-Block
+
+    WeightFormat fmt = WeightFormat::F32;
+    float scale_bound = 0.0f;           // I8: Skala neuer Blöcke (größter erlaubter Betrag)
+
+    RowSpans              rows;         // Zeile pro Pre-Neuron (mit Reserve)
+    pvector<uint32_t>     target;       // post | plastic << 24 | delay << 25
+
+    pvector<float>        w32;
+    pvector<uint16_t>     w16;
+    pvector<int8_t>       w8;
+    std::vector<float>    block_scale;  // nur I8
+
+    // Eingehende Synapsen pro Post-Neuron (CSC), nur für spike-getriebene STDP.
+    // Wird erst durch build_post_index() angelegt.
+    RowSpans              cols;          // Spalte pro Post-Neuron (mit Reserve)
+    std::vector<int>      in_pre;        // pre-ID der Synapse
+    std::vector<uint32_t> in_syn;        // Position k im Store
+    std::vector<uint32_t> csc_pos;       // pro Slot k: Position seines CSC-Eintrags
+
+    // Sortiert edges (Counting-Sort nach pre, dann post) und packt sie.
+    // w_abs_max: größter Betrag, den ein Gewicht später annehmen darf (für die I8-Skala)
+    void build(int n_pre, std::vector<Synapse>& edges, WeightFormat f, float w_abs_max, const RowRunner& run = {});
+    // Gewichte (in Store-Reihenfolge, Zeilen dicht hintereinander) ins Zielformat packen;
+    // jeder Zeilenbereich von run schreibt seine Slots selbst
+    void pack_weights(const std::vector<float>& w, WeightFormat f, float w_abs_max, const RowRunner& run = {});
+    void build_post_index(int n_post, float slack = 0.0f);
+    bool has_post_index() const { return !cols.start.empty(); }
+
+    size_t size() const     { return rows.live; }       // lebende Synapsen
+    size_t capacity() const { return target.size(); }   // Slots inkl. Reserve und Müll
+    int    row_begin(int pre) const { return static_cast<int>(rows.start[pre]); }
+    int    row_end(int pre)   const { return static_cast<int>(rows.start[pre] + rows.len[pre]); }
+    int    col_begin(int post) const { return static_cast<int>(cols.start[post]); }
+    int    col_end(int post)   const { return static_cast<int>(cols.start[post] + cols.len[post]); }
+
+    // --- Strukturelle Änderungen, Kosten ~ geänderte Synapsen ---
+    int    find(int pre, int post) const;   // Position oder -1
+    size_t add(int pre, int post, float w, int delay, bool plastic);
+    void   remove(int pre, size_t k);       // letzte Synapse der Zeile rückt nach k
+    bool   needs_compaction() const;        // Müll > Hälfte der Arrays
+    void   compact(float slack, const RowRunner& run = {});   // Zeilen (und CSC) dicht mit Reserve neu anlegen, in einem Zug
+    // im laufenden Betrieb: höchstens ~max_slots Slots pro Aufruf umziehen (erst Zeilen, dann CSC),
+    // Store bleibt dazwischen voll benutzbar. true, wenn dabei ein Durchgang fertig wurde
+    bool   compact_step(size_t max_slots, float slack);
+    bool   compacting() const { return rows.compacting || cols.compacting; }
+
+    int      post(size_t k)  const { return static_cast<int>(target[k] & kPostMask); }
+    uint16_t delay(size_t k) const { return static_cast<uint16_t>(target[k] >> kDelayShift); }
+    bool     plastic(size_t k) const { return (target[k] & kPlasticBit) != 0; }
+
+    static uint32_t pack_target(int post, int delay, bool plastic) {
+        const uint32_t d = static_cast<uint32_t>(std::clamp(delay, 0, kMaxDelay));
+        return static_cast<uint32_t>(post) | (plastic ? kPlasticBit : 0u) | (d << kDelayShift);
+    }
+
+    float weight(size_t k) const {
+        switch (fmt) {
+            case WeightFormat::F16: return half_to_float(w16[k]);
+            case WeightFormat::I8:  return w8[k] * block_scale[k >> kBlockShift];
+            default:                return w32[k];
+        }
+    }
+
+    void set_weight(size_t k, float w) {
+        switch (fmt) {
+            case WeightFormat::F16: w16[k] = float_to_half(w); break;
+            case WeightFormat::I8: {
+                const float s = block_scale[k >> kBlockShift];
+                const float q = (s > 0.0f) ? std::round(w / s) : 0.0f;
+                w8[k] = static_cast<int8_t>(std::clamp(q, -127.0f, 127.0f));
+                break;
+            }
+            default: w32[k] = w; break;
+        }
+    }
+
+    // Gewicht so gerundet, wie set_weight es ablegen würde (prozedurale Synapsen;
+    // I8 mit der Standard-Skala, Blöcke mit Ausreißern haben eine gröbere)
+    float quantize(float w) const {
+        switch (fmt) {
+            case WeightFormat::F16: return half_to_float(float_to_half(w));
+            case WeightFormat::I8: {
+                const float s = scale_bound / 127.0f;
+                if (s <= 0.0f) return 0.0f;
+                return static_cast<int8_t>(std::clamp(std::round(w / s), -127.0f, 127.0f)) * s;
+            }
+            default: return w;
+        }
+    }
+
+    size_t bytes_per_synapse() const;
+
+private:
+    void resize_slots(size_t n);            // Payload-Arrays auf n Slots
+    void move_slot(size_t from, size_t to); // Synapse umziehen (inkl. CSC-Rückverweis)
+    void csc_add(int post, int pre, uint32_t k);
+    void csc_remove(int post, uint32_t c);
+};
+
+WeightFormat parse_weight_format(const std::string& s);
@@ -0,0 +1,375 @@
+#include "telemetry.h"
+#include "binary_io.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+constexpr uint32_t kFileMagic  = 0x4C545242;   // "BRTL"
+constexpr uint32_t kBlockMagic = 0x4B4C4254;   // "TBLK"
+constexpr uint32_t kVersion    = 1;
+
+// Index-Eintrag pro Block in FILE.idx
+struct IndexEntry {
+    int64_t  t_first, t_last;
+    uint64_t offset;
+    uint32_t rows, reserved;
+};
+
+// ---------------- Bit-Ströme ----------------
+
+class BitWriter {
+public:
+    void put(uint64_t v, int n) {          // n niederwertigste Bits, MSB zuerst
+        for (int i = n - 1; i >= 0; --i) {
+            if (used_ == 0) buf_.push_back(0);
+            if ((v >> i) & 1u) buf_.back() |= static_cast<uint8_t>(0x80u >> used_);
+            used_ = (used_ + 1) & 7;
+        }
+    }
+    const std::vector<uint8_t>& bytes() const { return buf_; }
+private:
+    std::vector<uint8_t> buf_;
+    int used_ = 0;
+};
+
+class BitReader {
+public:
+    explicit BitReader(const std::vector<uint8_t>& b) : buf_(b) {}
+    uint64_t get(int n) {
+        uint64_t v = 0;
+        for (int i = 0; i < n; ++i) {
+            if (pos_ >= buf_.size() * 8) throw std::runtime_error("Telemetrie: Block zu kurz");
+            v = (v << 1) | ((buf_[pos_ >> 3] >> (7 - (pos_ & 7))) & 1u);
+            ++pos_;
+        }
+        return v;
+    }
+private:
+    const std::vector<uint8_t>& buf_;
+    size_t pos_ = 0;
+};
+
+// ---------------- Delta-of-Delta für Zeit/Tick ----------------
+
+void encode_dod(const std::vector<int64_t>& x, BitWriter& w) {
+    if (x.empty()) return;
+    w.put(static_cast<uint64_t>(x[0]), 64);
+    int64_t prev_delta = 0;
+    for (size_t i = 1; i < x.size(); ++i) {
+        const int64_t delta = x[i] - x[i - 1];
+        const int64_t dod = delta - prev_delta;
+        prev_delta = delta;
+        if (dod == 0)                        { w.put(0b0, 1); }
+        else if (dod >= -63 && dod <= 64)     { w.put(0b10, 2);   w.put(static_cast<uint64_t>(dod + 63), 7); }
+        else if (dod >= -255 && dod <= 256)   { w.put(0b110, 3);  w.put(static_cast<uint64_t>(dod + 255), 9); }
+        else if (dod >= -2047 && dod <= 2048) { w.put(0b1110, 4); w.put(static_cast<uint64_t>(dod + 2047), 12); }
+        else                                  { w.put(0b1111, 4); w.put(static_cast<uint64_t>(dod), 64); }
+    }
+}
+
+void decode_dod(BitReader& r, size_t n, std::vector<int64_t>& x) {
+    x.resize(n);
+    if (n == 0) return;
+    x[0] = static_cast<int64_t>(r.get(64));
+    int64_t delta = 0;
+    for (size_t i = 1; i < n; ++i) {
+        int64_t dod;
+        if (r.get(1) == 0)      dod = 0;
+        else if (r.get(1) == 0) dod = static_cast<int64_t>(r.get(7)) - 63;
+        else if (r.get(1) == 0) dod = static_cast<int64_t>(r.get(9)) - 255;
+        else if (r.get(1) == 0) dod = static_cast<int64_t>(r.get(12)) - 2047;
+        else                    dod = static_cast<int64_t>(r.get(64));
+        delta += dod;
+        x[i] = x[i - 1] + delta;
+    }
+}
+
+// ---------------- XOR-Kompression für Floats (Gorilla, 32 Bit) ----------------
+
+uint32_t float_bits(float f) { uint32_t u; std::memcpy(&u, &f, 4); return u; }
+float bits_float(uint32_t u) { float f; std::memcpy(&f, &u, 4); return f; }
+
+// Spalte c aus zeilenweisen Werten
+void encode_xor(const std::vector<float>& values, size_t rows, size_t cols, size_t c, BitWriter& w) {
+    if (rows == 0) return;
+    uint32_t prev = float_bits(values[c]);
+    w.put(prev, 32);
+    int lead = -1, trail = 0;                  // aktuelles Fenster signifikanter Bits
+    for (size_t i = 1; i < rows; ++i) {
+        const uint32_t cur = float_bits(values[i * cols + c]);
+        const uint32_t x = cur ^ prev;
+        prev = cur;
+        if (x == 0) { w.put(0b0, 1); continue; }
+        const int lz = std::min(31, __builtin_clz(x));
+        const int tz = __builtin_ctz(x);
+        if (lead >= 0 && lz >= lead && tz >= trail) {
+            // passt ins alte Fenster: nur die Bits dazwischen
+            w.put(0b10, 2);
+            w.put(x >> trail, 32 - lead - trail);
+        } else {
+            lead = lz;
+            trail = tz;
+            const int len = 32 - lz - tz;
+            w.put(0b11, 2);
+            w.put(static_cast<uint64_t>(lz), 5);
+            w.put(static_cast<uint64_t>(len - 1), 5);
+            w.put(x >> tz, len);
+        }
+    }
+}
+
+void decode_xor(BitReader& r, size_t rows, std::vector<float>& out) {
+    out.resize(rows);
+    if (rows == 0) return;
+    uint32_t prev = static_cast<uint32_t>(r.get(32));
+    out[0] = bits_float(prev);
+    int lead = 0, trail = 0;
+    for (size_t i = 1; i < rows; ++i) {
+        if (r.get(1) == 1) {
+            if (r.get(1) == 1) {
+                lead = static_cast<int>(r.get(5));
+                const int len = static_cast<int>(r.get(5)) + 1;
+                trail = 32 - lead - len;
+            }
+            const uint32_t x = static_cast<uint32_t>(r.get(32 - lead - trail)) << trail;
+            prev ^= x;
+        }
+        out[i] = bits_float(prev);
+    }
+}
+
+void put_column(std::ostream& o, const BitWriter& w) {
+    bio::put<uint32_t>(o, static_cast<uint32_t>(w.bytes().size()));
+    o.write(reinterpret_cast<const char*>(w.bytes().data()), w.bytes().size());
+}
+
+std::vector<uint8_t> get_column(std::istream& i) {
+    uint32_t n = 0;
+    bio::get(i, n);
+    std::vector<uint8_t> b(n);
+    if (n && !i.read(reinterpret_cast<char*>(b.data()), n)) throw std::runtime_error("Telemetrie: Block zu kurz");
+    return b;
+}
+
+std::vector<std::string> read_header(std::istream& in, const std::string& path) {
+    uint32_t magic = 0, version = 0, n = 0;
+    bio::get(in, magic);
+    bio::get(in, version);
+    if (magic != kFileMagic) throw std::runtime_error("Telemetrie: keine Telemetrie-Datei: " + path);
+    if (version != kVersion) throw std::runtime_error("Telemetrie: Version " + std::to_string(version) + " nicht unterstützt");
+    bio::get(in, n);
+    std::vector<std::string> cols(n);
+    for (auto& c : cols) bio::get_str(in, c);
+    return cols;
+}
+
+} // namespace
+
+// ======================= Writer =======================
+
+TelemetryWriter::~TelemetryWriter() { close(); }
+
+void TelemetryWriter::open(const std::string& path, const std::vector<std::string>& columns) {
+    close();
+    path_ = path;
+    cols_ = columns.size();
+
+    // 1️⃣ bestehendes Archiv: nur anhängen, wenn die Spalten gleich sind
+    bool append = false;
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (in && in.peek() != std::ifstream::traits_type::eof()) {
+            if (read_header(in, path) != columns)
+                throw std::runtime_error("Telemetrie: " + path + " hat andere Spalten (anderes Netz?)");
+            append = true;
+        }
+    }
+
+    out_.open(path, std::ios::binary | std::ios::app);
+    idx_.open(path + ".idx", std::ios::binary | std::ios::app);
+    if (!out_ || !idx_) throw std::runtime_error("Telemetrie: kann " + path + " nicht schreiben");
+    if (!append) {
+        bio::put(out_, kFileMagic);
+        bio::put(out_, kVersion);
+        bio::put<uint32_t>(out_, static_cast<uint32_t>(cols_));
+        for (const auto& c : columns) bio::put_str(out_, c);
+        out_.flush();
+    }
+
+    cur_ = Block{};
+    cur_.time.reserve(kRows);
+    cur_.tick.reserve(kRows);
+    cur_.values.reserve(kRows * cols_);
+    stop_ = false;
+    worker_ = std::thread(&TelemetryWriter::run, this);
+}
+
+void TelemetryWriter::record(int64_t time_ms, int64_t tick, const float* values) {
+    cur_.time.push_back(time_ms);
+    cur_.tick.push_back(tick);
+    cur_.values.insert(cur_.values.end(), values, values + cols_);
+    ++rows_;
+    if (cur_.time.size() < kRows) return;
+
+    // voller Block -> Hintergrund-Thread, Takt rechnet sofort weiter
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        queue_.push_back(std::move(cur_));
+    }
+    cv_.notify_one();
+    cur_ = Block{};
+    cur_.time.reserve(kRows);
+    cur_.tick.reserve(kRows);
+    cur_.values.reserve(kRows * cols_);
+}
+
+void TelemetryWriter::close() {
+    if (!worker_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (!cur_.time.empty()) queue_.push_back(std::move(cur_));
+        stop_ = true;
+    }
+    cv_.notify_one();
+    worker_.join();
+    cur_ = Block{};
+    out_.close();
+    idx_.close();
+}
+
+void TelemetryWriter::run() {
+    std::unique_lock<std::mutex> lock(mtx_);
+    while (true) {
+        cv_.wait(lock, [&] { return stop_ || !queue_.empty(); });
+        if (queue_.empty()) break;   // stop_ und nichts mehr zu tun
+        Block b = std::move(queue_.front());
+        queue_.pop_front();
+        lock.unlock();
+        write_block(b);
+        lock.lock();
+    }
+}
+
+void TelemetryWriter::write_block(const Block& b) {
+    const size_t rows = b.time.size();
+
+    // 2️⃣ jede Spalte für sich komprimieren
+    std::vector<BitWriter> cols(2 + cols_);
+    encode_dod(b.time, cols[0]);
+    encode_dod(b.tick, cols[1]);
+    for (size_t c = 0; c < cols_; ++c) encode_xor(b.values, rows, cols_, c, cols[2 + c]);
+
+    // 3️⃣ Block anhängen, dann Index-Eintrag (Index zeigt nie auf halbe Blöcke)
+    out_.seekp(0, std::ios::end);
+    const uint64_t offset = static_cast<uint64_t>(out_.tellp());
+    bio::put(out_, kBlockMagic);
+    bio::put<uint32_t>(out_, static_cast<uint32_t>(rows));
+    for (const auto& w : cols) put_column(out_, w);
+    out_.flush();
+
+    IndexEntry e{ b.time.front(), b.time.back(), offset, static_cast<uint32_t>(rows), 0 };
+    bio::put(idx_, e);
+    idx_.flush();
+
+    ++blocks_;
+    bytes_ = static_cast<uint64_t>(out_.tellp());
+}
+
+// ======================= Reader =======================
+
+TelemetryTable read_telemetry(const std::string& path, int64_t from_ms, int64_t to_ms) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("Telemetrie: kann " + path + " nicht lesen");
+
+    TelemetryTable t;
+    t.columns = read_header(in, path);
+    const size_t cols = t.columns.size();
+
+    // 1️⃣ Index lesen, nur überlappende Blöcke dekodieren
+    std::vector<IndexEntry> index;
+    {
+        std::ifstream idx(path + ".idx", std::ios::binary);
+        IndexEntry e;
+        while (idx.read(reinterpret_cast<char*>(&e), sizeof(e))) index.push_back(e);
+    }
+
+    std::vector<int64_t> time, tick;
+    std::vector<std::vector<float>> values(cols);
+    for (const auto& e : index) {
+        if (e.t_last < from_ms || e.t_first > to_ms) continue;
+        in.clear();
+        in.seekg(static_cast<std::streamoff>(e.offset));
+        uint32_t magic = 0, rows = 0;
+        bio::get(in, magic);
+        bio::get(in, rows);
+        if (magic != kBlockMagic || rows != e.rows) throw std::runtime_error("Telemetrie: Index passt nicht zur Datei");
+
+        {
+            const auto b = get_column(in);
+            BitReader r(b);
+            decode_dod(r, rows, time);
+        }
+        {
+            const auto b = get_column(in);
+            BitReader r(b);
+            decode_dod(r, rows, tick);
+        }
+        for (size_t c = 0; c < cols; ++c) {
+            const auto b = get_column(in);
+            BitReader r(b);
+            decode_xor(r, rows, values[c]);
+        }
+
+        // 2️⃣ Zeilen im Bereich übernehmen
+        for (uint32_t i = 0; i < rows; ++i) {
+            if (time[i] < from_ms || time[i] > to_ms) continue;
+            t.time_ms.push_back(time[i]);
+            t.tick.push_back(tick[i]);
+            for (size_t c = 0; c < cols; ++c) t.values.push_back(values[c][i]);
+        }
+    }
+    return t;
+}
+
+int run_telemetry_query(const std::string& path, int64_t from_ms, int64_t to_ms, const std::string& columns) {
+    TelemetryTable t;
+    try {
+        t = read_telemetry(path, from_ms, to_ms);
+    } catch (const std::exception& e) {
+        std::cerr << "❌ " << e.what() << "\n";
+        return 1;
+    }
+
+    // gewünschte Spalten auflösen
+    std::vector<size_t> pick;
+    if (columns.empty()) {
+        for (size_t c = 0; c < t.columns.size(); ++c) pick.push_back(c);
+    } else {
+        std::stringstream ss(columns);
+        std::string name;
+        while (std::getline(ss, name, ',')) {
+            auto it = std::find(t.columns.begin(), t.columns.end(), name);
+            if (it == t.columns.end()) {
+                std::cerr << "❌ Unbekannte Spalte: " << name << "\n";
+                return 1;
+            }
+            pick.push_back(static_cast<size_t>(it - t.columns.begin()));
+        }
+    }
+
+    std::cout << "time_ms,tick";
+    for (size_t c : pick) std::cout << ',' << t.columns[c];
+    std::cout << "\n";
+    const size_t cols = t.columns.size();
+    for (size_t i = 0; i < t.time_ms.size(); ++i) {
+        std::cout << t.time_ms[i] << ',' << t.tick[i];
+        for (size_t c : pick) std::cout << ',' << t.values[i * cols + c];
+        std::cout << "\n";
+    }
+    std::cerr << "📼 " << t.time_ms.size() << " Zeilen aus " << path << "\n";
+    return 0;
+}
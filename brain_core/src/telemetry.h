@@ -0,0 +1,72 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+
+// Langzeit-Telemetrie: spaltenweise, Gorilla-komprimiert.
+//
+//  - Zeilen = (Wanduhr in ms, Tick, n Float-Werte), z.B. Hormone, Spikes pro Population, Schrittzeit.
+//  - Je kRows Zeilen bilden einen Block; jede Spalte wird im Block für sich komprimiert:
+//    Zeit/Tick als Delta-of-Delta, Floats als XOR mit dem Vorgänger (meist nur wenige Bits).
+//  - FILE.idx hält pro Block (Zeitbereich, Offset): eine Abfrage liest nur passende Blöcke.
+//  - Komprimieren und Schreiben laufen in einem Hintergrund-Thread, der Takt übergibt nur volle Blöcke.
+//  - Gleiche Spalten -> an eine bestehende Datei anhängen (ein Archiv über viele Läufe).
+class TelemetryWriter {
+public:
+    static constexpr uint32_t kRows = 1024;
+
+    ~TelemetryWriter();
+
+    void open(const std::string& path, const std::vector<std::string>& columns);   // wirft bei Fehlern
+    bool is_open() const { return worker_.joinable(); }
+
+    // values: eine Zahl pro Spalte
+    void record(int64_t time_ms, int64_t tick, const float* values);
+
+    void close();   // angefangenen Block schreiben, Thread beenden
+
+    uint64_t rows() const   { return rows_; }
+    uint64_t blocks() const { return blocks_; }
+    uint64_t bytes() const  { return bytes_; }
+
+private:
+    struct Block {
+        std::vector<int64_t> time, tick;
+        std::vector<float> values;   // zeilenweise, rows × cols
+    };
+
+    void run();
+    void write_block(const Block& b);
+
+    std::string path_;
+    size_t cols_ = 0;
+    Block cur_;
+    std::ofstream out_, idx_;
+
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::deque<Block> queue_;
+    bool stop_ = false;
+    std::thread worker_;
+
+    std::atomic<uint64_t> rows_{0}, blocks_{0}, bytes_{0};
+};
+
+// dekodierter Ausschnitt
+struct TelemetryTable {
+    std::vector<std::string> columns;
+    std::vector<int64_t> time_ms, tick;
+    std::vector<float> values;   // zeilenweise, rows × columns.size()
+};
+
+// alle Zeilen mit from_ms <= time_ms <= to_ms
+TelemetryTable read_telemetry(const std::string& path, int64_t from_ms, int64_t to_ms);
+
+// --telemetry-query: Ausschnitt als CSV auf stdout; columns = kommagetrennt, leer = alle
+int run_telemetry_query(const std::string& path, int64_t from_ms, int64_t to_ms, const std::string& columns);
@@ -0,0 +1,63 @@
+#include "worker_pool.h"
+#include <pthread.h>
+#include <sched.h>
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto& t : threads_) t.join();
+}
+
+void WorkerPool::start(int n, bool pin) {
+    // erlaubte CPUs des Prozesses (z.B. durch taskset/cgroup eingeschränkt)
+    std::vector<int> cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (pin && sched_getaffinity(0, sizeof(set), &set) == 0)
+        for (int c = 0; c < CPU_SETSIZE; ++c)
+            if (CPU_ISSET(c, &set)) cpus.push_back(c);
+
+    for (int w = 0; w < n; ++w) {
+        const int cpu = cpus.empty() ? -1 : cpus[w % cpus.size()];
+        threads_.emplace_back(&WorkerPool::loop, this, w, cpu);
+    }
+}
+
+void WorkerPool::run(const std::function<void(int)>& fn) {
+    std::unique_lock<std::mutex> lock(m_);
+    job_ = &fn;
+    pending_ = size();
+    ++gen_;
+    cv_.notify_all();
+    done_cv_.wait(lock, [&] { return pending_ == 0; });
+    job_ = nullptr;
+}
+
+void WorkerPool::loop(int w, int cpu) {
+    if (cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+
+    uint64_t seen = 0;
+    for (;;) {
+        const std::function<void(int)>* fn;
+        {
+            std::unique_lock<std::mutex> lock(m_);
+            cv_.wait(lock, [&] { return stop_ || gen_ != seen; });
+            if (stop_) return;
+            seen = gen_;
+            fn = job_;
+        }
+        (*fn)(w);
+        {
+            std::lock_guard<std::mutex> lock(m_);
+            if (--pending_ == 0) done_cv_.notify_one();
+        }
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <cstdint>
+
+// Feste Worker-Threads, je einer pro Partition, optional an einen CPU-Kern gepinnt.
+// Worker w bearbeitet immer dieselbe Partition -> dieselben Speicherseiten (First Touch).
+// run() ist eine Barriere: kehrt zurück, wenn alle Worker fertig sind.
+class WorkerPool {
+public:
+    ~WorkerPool();
+
+    void start(int n, bool pin);
+    int  size() const { return static_cast<int>(threads_.size()); }
+    void run(const std::function<void(int)>& fn);   // fn(w) auf jedem Worker
+
+private:
+    void loop(int w, int cpu);
+
+    std::vector<std::thread> threads_;
+    const std::function<void(int)>* job_ = nullptr;
+    std::mutex m_;
+    std::condition_variable cv_, done_cv_;
+    uint64_t gen_ = 0;
+    int  pending_ = 0;
+    bool stop_ = false;
+};
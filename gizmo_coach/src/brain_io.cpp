@@ -1,4 +1,5 @@
 #include "brain_io.h"
+#include "feedback_coalescer.h"
 #include <nlohmann/json.hpp>
 #include <fstream>
 #include <chrono>
@@ -57,14 +58,8 @@ void send_set_hormones(const std::string& path, float dopa, float cort, float ad
 // -------------------------------------------------------------
 void apply_feedback(const std::string& path, const Decision& d, int seq)
 {
-    float I = std::clamp(d.intensity, 0.0f, 1.0f);
-
-    if (d.feedback == "reward")
-        send_set_hormones(path, +0.3f + 0.7f * I, -0.1f * I, 0.1f * I, seq);
-    else if (d.feedback == "punish")
-        send_set_hormones(path, -0.2f * I, +0.4f + 0.6f * I, 0.05f * I, seq);
-    else
-        send_set_hormones(path, 0.0f, 0.0f, 0.05f * I, seq);
+    const auto drive = feedback_drive(d);
+    send_set_hormones(path, drive.dopamine, drive.cortisol, drive.adrenaline, seq);
 }
 
 // -------------------------------------------------------------
@@ -83,3 +78,33 @@ void send_input_pattern(const std::string& path, const std::vector<int>& pat, in
 
     write_command(path, meta, data);
 }
+
+// -------------------------------------------------------------
+// Input-Sequenz (ein dünnes Muster pro Token)
+// -------------------------------------------------------------
+void send_input_sequence(const std::string& path, const std::vector<SdrEncoder::Step>& steps,
+                         int ticks_per_token, float amplitude, int seq)
+{
+    nlohmann::json arr = nlohmann::json::array();
+    nlohmann::json tokens = nlohmann::json::array();
+    for (const auto& s : steps) {
+        arr.push_back(s.bits);
+        tokens.push_back(s.token);
+    }
+
+    nlohmann::json data = {
+        {"ticks_per_token", ticks_per_token},
+        {"amplitude", amplitude},
+        {"steps", arr},
+        {"tokens", tokens}
+    };
+
+    CommandMeta meta{
+        now_seconds(),
+        seq,
+        "coach",
+        "input_sequence"
+    };
+
+    write_command(path, meta, data);
+}
@@ -2,6 +2,7 @@
 #include <string>
 #include <vector>
 #include "coach_logic.h"
+#include "sdr_encoder.h"
 #include <nlohmann/json.hpp>
 
 struct CommandMeta {
@@ -15,4 +16,7 @@ void write_command(const std::string& path, const CommandMeta& meta, const nlohm
 
 void send_set_hormones(const std::string& path, float dopa, float cort, float adre, int seq = 0);
 void apply_feedback(const std::string& path, const Decision& d, int seq = 0);
-void send_input_pattern(const std::string& path, const std::vector<int>& pat, int seq = 0);
\ No newline at end of file
+void send_input_pattern(const std::string& path, const std::vector<int>& pat, int seq = 0);
+// Folge dünner Muster: pro Schritt ticks_per_token Ticks lang die Input-Indizes bits
+void send_input_sequence(const std::string& path, const std::vector<SdrEncoder::Step>& steps,
+                         int ticks_per_token, float amplitude, int seq = 0);
@@ -2,6 +2,8 @@
 #include <sstream>
 #include <nlohmann/json.hpp>
 #include <algorithm>
+#include <cmath>
+#include "sentiment_scorer.h"
 
 std::string build_prompt() {
     std::ostringstream p;
@@ -24,53 +26,21 @@ std::string build_prompt() {
     return p.str();
 }
 
-bool parse_decision(const std::string& raw, Decision& d) {
-    if (raw.empty()) return false;
-    d.reply = raw;
-
-    // Lowercase-Kopie für Vergleiche
-    std::string text;
-    text.reserve(raw.size());
-    for (char c : raw)
-        text.push_back(std::tolower(static_cast<unsigned char>(c)));
-
-    // Wörterlisten (kannst du beliebig erweitern)
-    static const std::vector<std::string> positive = {
-        "gut","freue","danke","toll","super","gern","wunderbar","zufrieden","happy",
-        "glücklich","schön","lieb","love","mag","nice","yay","ok","okay"
-    };
-    static const std::vector<std::string> negative = {
-        "schlecht","nicht gut","traurig","hasse","angst","doof","wütend","böse",
-        "nein","fail","fehler","müde","stress","sorge","nervt","schlimm","negativ","kaputt"
-    };
-
-    // Emotionale Punktzahl [-3 .. +3]
-    int score = 0;
-    for (auto& w : positive)
-        if (text.find(w) != std::string::npos) score++;
-    for (auto& w : negative)
-        if (text.find(w) != std::string::npos) score--;
-
-    // Verstärker durch Ausdrucksweise
-    int exclaim = std::count(text.begin(), text.end(), '!');
-    int question = std::count(text.begin(), text.end(), '?');
-
-    score += exclaim;
-    score -= (question > 2) ? 1 : 0;
+namespace {
 
-    // Emojis
-    if (text.find("😊") != std::string::npos || text.find(":)") != std::string::npos)
-        score++;
-    if (text.find("😡") != std::string::npos || text.find("☹️") != std::string::npos)
-        score--;
+// Score -> Feedback + Intensität (gleiche Regeln für Einzel- und Batch-Aufruf)
+void decide(const std::string& raw, const SentimentScore& s, Decision& d) {
+    d.reply = raw;
 
-    // Ergebnis clampen
-    score = std::max(-3, std::min(3, score));
+    // Emotionale Punktzahl [-3 .. +3], Verstärker durch Ausdrucksweise
+    float score = s.score + static_cast<float>(s.exclaim);
+    score -= (s.question > 2) ? 1.0f : 0.0f;
+    score = std::clamp(score, -3.0f, 3.0f);
 
     // Feedbacktyp bestimmen
-    if (score > 0)
+    if (score > 0.0f)
         d.feedback = "reward";
-    else if (score < 0)
+    else if (score < 0.0f)
         d.feedback = "punish";
     else
         d.feedback = "none";
@@ -79,7 +49,22 @@ bool parse_decision(const std::string& raw, Decision& d) {
     // und ein bisschen vom Antwortvolumen (je emotionaler, desto mehr Text)
     float base = std::clamp(std::abs(score) / 3.0f, 0.0f, 1.0f);
     float size_factor = std::clamp(static_cast<float>(raw.size()) / 100.0f, 0.0f, 1.0f);
-    d.intensity = std::clamp(0.4f * base + 0.3f * size_factor + 0.3f * (exclaim > 0 ? 1.0f : 0.0f), 0.0f, 1.0f);
+    d.intensity = std::clamp(0.4f * base + 0.3f * size_factor + 0.3f * (s.exclaim > 0 ? 1.0f : 0.0f), 0.0f, 1.0f);
+}
 
+} // namespace
+
+bool parse_decision(const std::string& raw, Decision& d) {
+    if (raw.empty()) return false;
+    // Lexikon (Wörter + Emojis) und Satzzeichen in einem Durchgang
+    decide(raw, SentimentScorer::shared().score(raw), d);
     return true;
-}
\ No newline at end of file
+}
+
+std::vector<Decision> parse_decisions(const std::vector<std::string>& raws) {
+    const auto scores = SentimentScorer::shared().score_batch(raws);
+    std::vector<Decision> out(raws.size());
+    for (size_t i = 0; i < raws.size(); ++i)
+        decide(raws[i], scores[i], out[i]);
+    return out;
+}
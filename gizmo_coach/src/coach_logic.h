@@ -1,6 +1,7 @@
 
 #pragma once
 #include <string>
+#include <vector>
 #include "hormons_reader.h"
 
 struct Decision {
@@ -11,3 +12,5 @@ struct Decision {
 
 std::string build_prompt();
 bool parse_decision(const std::string& raw, Decision& d);
+// viele Antworten auf einmal (leere Texte -> feedback "none")
+std::vector<Decision> parse_decisions(const std::vector<std::string>& raws);
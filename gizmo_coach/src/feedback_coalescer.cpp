@@ -0,0 +1,156 @@
+#include "feedback_coalescer.h"
+#include "brain_io.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include <iostream>
+
+FeedbackCoalescer::Drive feedback_drive(const Decision& d) {
+    const float I = std::clamp(d.intensity, 0.0f, 1.0f);
+    if (d.feedback == "reward") return { +0.3f + 0.7f * I, -0.1f * I, 0.1f * I, I };
+    if (d.feedback == "punish") return { -0.2f * I, +0.4f + 0.6f * I, 0.05f * I, -I };
+    return { 0.0f, 0.0f, 0.05f * I, 0.0f };
+}
+
+FeedbackCoalescer::Merge parse_merge_policy(const std::string& s) {
+    if (s == "sum")   return FeedbackCoalescer::Merge::Sum;
+    if (s == "max")   return FeedbackCoalescer::Merge::Max;
+    if (s == "decay") return FeedbackCoalescer::Merge::Decay;
+    throw std::runtime_error("Unbekannte Merge-Policy: " + s + " (sum|max|decay)");
+}
+
+FeedbackCoalescer::Drive FeedbackCoalescer::combine(const std::vector<Drive>& drives, const std::vector<double>& ages_ms,
+                                                    Merge merge, int half_life_ms) {
+    Drive r;
+    if (drives.empty()) return r;
+
+    switch (merge) {
+    case Merge::Sum:
+        for (const auto& d : drives) {
+            r.dopamine += d.dopamine;
+            r.cortisol += d.cortisol;
+            r.adrenaline += d.adrenaline;
+            r.reward += d.reward;
+        }
+        break;
+    case Merge::Max: {
+        // bei Gleichstand gewinnt der frühere Eintrag -> unabhängig vom Timing im Fenster
+        auto pick = [](float cur, float x) { return std::fabs(x) > std::fabs(cur) ? x : cur; };
+        for (const auto& d : drives) {
+            r.dopamine = pick(r.dopamine, d.dopamine);
+            r.cortisol = pick(r.cortisol, d.cortisol);
+            r.adrenaline = pick(r.adrenaline, d.adrenaline);
+            r.reward = pick(r.reward, d.reward);
+        }
+        break;
+    }
+    case Merge::Decay: {
+        double w_sum = 0, dopa = 0, cort = 0, adre = 0, rew = 0;
+        for (size_t i = 0; i < drives.size(); ++i) {
+            const double w = std::pow(0.5, ages_ms[i] / std::max(1, half_life_ms));
+            dopa += w * drives[i].dopamine;
+            cort += w * drives[i].cortisol;
+            adre += w * drives[i].adrenaline;
+            rew  += w * drives[i].reward;
+            w_sum += w;
+        }
+        r = { static_cast<float>(dopa / w_sum), static_cast<float>(cort / w_sum), static_cast<float>(adre / w_sum),
+              static_cast<float>(rew / w_sum) };
+        break;
+    }
+    }
+    r.dopamine = std::clamp(r.dopamine, -1.0f, 1.0f);
+    r.cortisol = std::clamp(r.cortisol, -1.0f, 1.0f);
+    r.adrenaline = std::clamp(r.adrenaline, -1.0f, 1.0f);
+    r.reward = std::clamp(r.reward, -1.0f, 1.0f);
+    return r;
+}
+
+FeedbackCoalescer::FeedbackCoalescer(std::string path, int window_ms, Merge merge, int half_life_ms)
+    : path_(std::move(path)), window_ms_(std::max(1, window_ms)), merge_(merge), half_life_ms_(half_life_ms) {
+    worker_ = std::thread(&FeedbackCoalescer::run, this);
+}
+
+FeedbackCoalescer::~FeedbackCoalescer() {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    if (worker_.joinable()) worker_.join();
+}
+
+void FeedbackCoalescer::submit(const Decision& d) {
+    const auto now = Clock::now();
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        // erste Anfrage öffnet das Fenster, weitere hängen sich an
+        if (pending_.empty()) window_end_ = now + std::chrono::milliseconds(window_ms_);
+        pending_.push_back({ feedback_drive(d), now });
+    }
+    cv_.notify_all();
+}
+
+void FeedbackCoalescer::flush() {
+    std::unique_lock<std::mutex> lock(mtx_);
+    write_locked(lock);
+}
+
+void FeedbackCoalescer::write_locked(std::unique_lock<std::mutex>& lock) {
+    if (pending_.empty()) return;
+    std::vector<Pending> batch;
+    batch.swap(pending_);
+    const int seq = ++seq_;
+    const auto end = window_end_;
+    lock.unlock();   // Datei-I/O ohne Lock, neue Anfragen öffnen schon das nächste Fenster
+
+    std::vector<Drive> drives;
+    std::vector<double> ages;
+    drives.reserve(batch.size());
+    ages.reserve(batch.size());
+    for (const auto& p : batch) {
+        drives.push_back(p.drive);
+        ages.push_back(std::chrono::duration<double, std::milli>(end - p.at).count());
+    }
+    const Drive m = combine(drives, ages, merge_, half_life_ms_);
+
+    nlohmann::json data = {
+        {"dopamine", m.dopamine},
+        {"cortisol", m.cortisol},
+        {"adrenaline", m.adrenaline},
+        {"batch", batch.size()}
+    };
+    const double ts = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+    write_command(path_, CommandMeta{ ts, seq, "coach", "set_hormones" }, data);
+    // Drei-Faktor-Lernen: derselbe Feedback-Wert als Reward auf die Eligibility-Traces
+    if (m.reward != 0.0f)
+        write_command(path_, CommandMeta{ ts, seq, "coach", "reward" }, { {"value", m.reward}, {"batch", batch.size()} });
+
+    lock.lock();
+}
+
+void FeedbackCoalescer::run() {
+    std::unique_lock<std::mutex> lock(mtx_);
+    while (!stop_) {
+        if (pending_.empty()) {
+            cv_.wait(lock, [&] { return stop_ || !pending_.empty(); });
+            continue;
+        }
+        // bis Fensterende warten, dann einmal schreiben
+        if (cv_.wait_until(lock, window_end_, [&] { return stop_; })) break;
+        write_locked(lock);
+    }
+    write_locked(lock);   // Rest beim Beenden nicht verlieren
+}
+
+FeedbackCoalescer& FeedbackCoalescer::shared() {
+    static FeedbackCoalescer c = [] {
+        int window = 100;
+        Merge merge = Merge::Decay;
+        if (const char* e = std::getenv("GIZMO_FEEDBACK_WINDOW_MS")) window = std::atoi(e);
+        if (const char* e = std::getenv("GIZMO_FEEDBACK_MERGE")) merge = parse_merge_policy(e);
+        return FeedbackCoalescer("./../brain_core/io/in/commands.jsonl", window, merge);
+    }();
+    return c;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include "coach_logic.h"
+
+// Sammelt Reward/Punish-Anfragen eines Zeitfensters und schreibt höchstens einen
+// set_hormones-Befehl (plus einen reward-Befehl) pro Fenster. Vorher überschrieb jede Anfrage den Drive der
+// vorigen, unter Last entschied die zufällig letzte Zeile.
+class FeedbackCoalescer {
+public:
+    // Sum:   Drives addieren (danach auf [-1, 1] begrenzt)
+    // Max:   pro Hormon der betragsgrößte Drive
+    // Decay: gewichteter Mittelwert, Gewicht 0.5^(Alter / half_life) zum Fensterende
+    enum class Merge { Sum, Max, Decay };
+
+    // reward: Drei-Faktor-Signal fürs Gehirn (Befehl "reward", wirkt nur mit --plasticity reward)
+    struct Drive { float dopamine = 0, cortisol = 0, adrenaline = 0, reward = 0; };
+
+    FeedbackCoalescer(std::string path, int window_ms, Merge merge, int half_life_ms = 200);
+    ~FeedbackCoalescer();
+
+    void submit(const Decision& d);   // thread-sicher, kehrt sofort zurück
+    void flush();                     // offenes Fenster jetzt schreiben
+
+    Merge merge() const { return merge_; }
+    int window_ms() const { return window_ms_; }
+
+    // commands.jsonl des Gehirns; Fenster/Policy aus GIZMO_FEEDBACK_WINDOW_MS (100)
+    // und GIZMO_FEEDBACK_MERGE (sum|max|decay, Default decay)
+    static FeedbackCoalescer& shared();
+
+    // reine Zusammenführung, ages_ms = Abstand jedes Eintrags zum Fensterende
+    static Drive combine(const std::vector<Drive>& drives, const std::vector<double>& ages_ms,
+                         Merge merge, int half_life_ms);
+
+private:
+    using Clock = std::chrono::steady_clock;
+    struct Pending { Drive drive; Clock::time_point at; };
+
+    void run();
+    void write_locked(std::unique_lock<std::mutex>& lock);
+
+    std::string path_;
+    int   window_ms_;
+    Merge merge_;
+    int   half_life_ms_;
+
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::vector<Pending> pending_;
+    Clock::time_point window_end_{};
+    bool stop_ = false;
+    int  seq_ = 0;
+    std::thread worker_;
+};
+
+FeedbackCoalescer::Merge parse_merge_policy(const std::string& s);
+FeedbackCoalescer::Drive feedback_drive(const Decision& d);   // Feedback -> Hormon-Drive
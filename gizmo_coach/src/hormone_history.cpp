@@ -0,0 +1,127 @@
+#include "hormone_history.h"
+#include <algorithm>
+#include <chrono>
+
+const char* const HormoneHistory::kNames[kChannels] = {
+    "dopamine", "serotonin", "cortisol", "adrenaline", "oxytocin", "melatonin",
+    "noradrenaline", "endorphin", "acetylcholine", "testosterone", "spikes"
+};
+
+HormoneHistory::HormoneHistory() {
+    // 10 ms × 1000 = 10 s, 1 s × 600 = 10 min, 1 min × 1440 = 24 h
+    tiers_.push_back({ 10,    std::vector<Bucket>(1000) });
+    tiers_.push_back({ 1000,  std::vector<Bucket>(600) });
+    tiers_.push_back({ 60000, std::vector<Bucket>(1440) });
+}
+
+int64_t HormoneHistory::now_ms() {
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+int HormoneHistory::channel(const std::string& name) {
+    for (int c = 0; c < kChannels; ++c)
+        if (name == kNames[c]) return c;
+    return -1;
+}
+
+void HormoneHistory::add(const Hormones& H, float spikes) {
+    add(now_ms(), H, spikes);
+}
+
+void HormoneHistory::add(int64_t t_ms, const Hormones& H, float spikes) {
+    const float x[kChannels] = {
+        H.dopamine, H.serotonin, H.cortisol, H.adrenaline, H.oxytocin, H.melatonin,
+        H.noradrenaline, H.endorphin, H.acetylcholine, H.testosterone, spikes
+    };
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    latest_ms_ = std::max(latest_ms_, t_ms);
+    for (auto& tier : tiers_) {
+        const int64_t idx = t_ms / tier.resolution_ms;
+        Bucket& b = tier.ring[static_cast<size_t>(idx % static_cast<int64_t>(tier.ring.size()))];
+        if (b.index != idx) {          // Eimer gehört zu einer alten Runde -> neu beginnen
+            b.index = idx;
+            b.count = 0;
+        }
+        for (int c = 0; c < kChannels; ++c) {
+            Agg& a = b.v[c];
+            if (b.count == 0) a = { x[c], x[c], 0.0f, x[c], x[c] };
+            a.min = std::min(a.min, x[c]);
+            a.max = std::max(a.max, x[c]);
+            a.sum += x[c];
+            a.last = x[c];
+        }
+        ++b.count;
+    }
+}
+
+HormoneHistory::Window HormoneHistory::query(int64_t window_ms) const {
+    int64_t now;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        now = latest_ms_;
+    }
+    return query(now, window_ms);
+}
+
+HormoneHistory::Window HormoneHistory::query(int64_t now_ms, int64_t window_ms) const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    Window w;
+    window_ms = std::max<int64_t>(1, window_ms);
+
+    // 1️⃣ Stufe wählen: feinste, bei der das Fenster in kMaxScan Eimer passt (sonst gröbste)
+    const Tier* tier = &tiers_.back();
+    for (const auto& t : tiers_) {
+        const int64_t n = (window_ms + t.resolution_ms - 1) / t.resolution_ms;
+        if (n <= kMaxScan && n <= static_cast<int64_t>(t.ring.size())) { tier = &t; break; }
+    }
+    w.resolution_ms = tier->resolution_ms;
+    const int64_t cap = static_cast<int64_t>(tier->ring.size());
+    const int64_t n = std::min(cap, (window_ms + tier->resolution_ms - 1) / tier->resolution_ms);
+    const int64_t last_idx = now_ms / tier->resolution_ms;
+
+    // 2️⃣ höchstens kMaxScan Eimer (bzw. Ringgröße) zusammenfassen, alt -> neu
+    std::array<double, kChannels> sum{};
+    int64_t first_idx = -1, prev_idx = -1;
+    std::array<float, kChannels> first_mean{}, last_mean{};
+    for (int64_t idx = last_idx - n + 1; idx <= last_idx; ++idx) {
+        if (idx < 0) continue;
+        const Bucket& b = tier->ring[static_cast<size_t>(idx % cap)];
+        if (b.index != idx || b.count == 0) continue;
+        for (int c = 0; c < kChannels; ++c) {
+            const Agg& a = b.v[c];
+            Stat& s = w.ch[c];
+            const float mean = a.sum / b.count;
+            if (first_idx < 0) {
+                s.first = a.first;
+                s.min = a.min;
+                s.max = a.max;
+                first_mean[c] = mean;
+            }
+            s.min = std::min(s.min, a.min);
+            s.max = std::max(s.max, a.max);
+            s.last = a.last;
+            s.samples += b.count;
+            sum[c] += a.sum;
+            last_mean[c] = mean;
+        }
+        if (first_idx < 0) first_idx = idx;
+        prev_idx = idx;
+        ++w.buckets;
+    }
+    if (w.buckets == 0) return w;
+
+    const double span_s = static_cast<double>((prev_idx - first_idx) * tier->resolution_ms) / 1000.0;
+    for (int c = 0; c < kChannels; ++c) {
+        Stat& s = w.ch[c];
+        s.mean = static_cast<float>(sum[c] / std::max(1, s.samples));
+        s.slope = span_s > 0 ? static_cast<float>((last_mean[c] - first_mean[c]) / span_s) : 0.0f;
+    }
+    return w;
+}
+
+HormoneHistory& HormoneHistory::shared() {
+    static HormoneHistory h;
+    return h;
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <string>
+#include <mutex>
+#include <cstdint>
+#include "hormons_reader.h"
+
+// Zeitreihen im Speicher: Hormone + Spike-Rate, in mehreren Auflösungen
+// (10 ms, 1 s, 1 min) als Ringe fester Größe. Jeder Eimer hält min/max/Summe/
+// erster/letzter Wert; ältere Eimer werden beim Überschreiben einfach verworfen.
+// Speicher und Kosten pro Abfrage sind damit konstant, egal wie lange der Coach läuft.
+class HormoneHistory {
+public:
+    static constexpr int kChannels = 11;   // 10 Hormone + spikes
+    static const char* const kNames[kChannels];
+
+    struct Stat {
+        float first = 0, last = 0, min = 0, max = 0, mean = 0;
+        float slope = 0;      // (letzter - erster Eimer-Mittelwert) pro Sekunde
+        int   samples = 0;
+    };
+
+    struct Window {
+        int64_t resolution_ms = 0;   // benutzte Stufe
+        int     buckets = 0;         // gefüllte Eimer im Fenster
+        std::array<Stat, kChannels> ch{};
+    };
+
+    HormoneHistory();
+
+    void add(int64_t t_ms, const Hormones& H, float spikes);
+    void add(const Hormones& H, float spikes);   // mit steady_clock-Zeit
+
+    // Fenster [now - window_ms, now]: feinste Stufe, die das Fenster mit <= kMaxScan Eimern abdeckt
+    Window query(int64_t window_ms) const;
+    Window query(int64_t now_ms, int64_t window_ms) const;
+
+    static int channel(const std::string& name);   // -1 wenn unbekannt
+    static int64_t now_ms();
+
+    static HormoneHistory& shared();
+
+private:
+    static constexpr int kMaxScan = 120;
+
+    struct Agg { float min, max, sum, first, last; };
+    struct Bucket {
+        int64_t index = -1;          // t / resolution, -1 = leer
+        int     count = 0;
+        std::array<Agg, kChannels> v;
+    };
+    struct Tier {
+        int64_t resolution_ms;
+        std::vector<Bucket> ring;
+    };
+
+    std::vector<Tier> tiers_;
+    int64_t latest_ms_ = 0;
+    mutable std::mutex mtx_;
+};
@@ -0,0 +1,190 @@
+#include "hormone_hub.h"
+#include "log_tail.h"
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <iostream>
+#include <filesystem>
+#include <iterator>
+#include <limits>
+#include <nlohmann/json.hpp>
+
+namespace {
+
+float max_delta(const Hormones& a, const Hormones& b) {
+    const float d[] = {
+        a.dopamine - b.dopamine, a.serotonin - b.serotonin, a.cortisol - b.cortisol,
+        a.adrenaline - b.adrenaline, a.oxytocin - b.oxytocin, a.melatonin - b.melatonin,
+        a.noradrenaline - b.noradrenaline, a.endorphin - b.endorphin,
+        a.acetylcholine - b.acetylcholine, a.testosterone - b.testosterone
+    };
+    float m = 0.0f;
+    for (float x : d) m = std::max(m, std::fabs(x));
+    return m;
+}
+
+// Spike-Zahl eines Logs schwankt von Zeile zu Zeile: erst ab rel. Änderung (mind. 5 Spikes)
+bool spikes_changed(long last, long now, float rel) {
+    const long d = std::labs(now - last);
+    return d >= 5 && d > rel * static_cast<float>(std::max(last, 1L));
+}
+
+// kompakt: drei Nachkommastellen reichen für den Prompt
+double r3(float x) { return std::round(static_cast<double>(x) * 1000.0) / 1000.0; }
+
+// so viele Updates bleiben für Abonnenten, die mehr als eins zurückliegen
+constexpr size_t kRecentUpdates = 256;
+
+// gap: der Abonnent lag weiter zurück als der Ring reicht, Tokens dazwischen fehlen
+std::string to_json(const HormoneHub::Update& u, bool gap) {
+    nlohmann::json tk = nlohmann::json::array();
+    std::string text;
+    for (const auto& t : u.tokens) {
+        tk.push_back({ {"tick", t.tick}, {"token", t.token}, {"output", t.output} });
+        text += t.token;
+    }
+    const Hormones& H = u.hormones;
+    nlohmann::json j = {
+        {"seq", u.seq}, {"tick", u.tick}, {"spikes", u.spikes},
+        {"hormones", {
+            {"dopamine", r3(H.dopamine)}, {"serotonin", r3(H.serotonin)}, {"cortisol", r3(H.cortisol)},
+            {"adrenaline", r3(H.adrenaline)}, {"oxytocin", r3(H.oxytocin)}, {"melatonin", r3(H.melatonin)},
+            {"noradrenaline", r3(H.noradrenaline)}, {"endorphin", r3(H.endorphin)},
+            {"acetylcholine", r3(H.acetylcholine)}, {"testosterone", r3(H.testosterone)}
+        }},
+        {"tokens", tk}, {"text", text}
+    };
+    if (gap) j["gap"] = true;
+    return j.dump();
+}
+
+} // namespace
+
+HormoneHub::HormoneHub(std::string path, std::string tokens_path, float epsilon, float spike_delta, int poll_ms)
+    : path_(std::move(path)), tokens_path_(std::move(tokens_path)), epsilon_(epsilon), spike_delta_(spike_delta),
+      poll_ms_(std::max(1, poll_ms)) {}
+
+HormoneHub::~HormoneHub() { stop(); }
+
+void HormoneHub::start() {
+    if (running_.exchange(true)) return;
+    worker_ = std::thread(&HormoneHub::run, this);
+}
+
+void HormoneHub::stop() {
+    if (!running_.exchange(false)) return;
+    cv_.notify_all();
+    if (worker_.joinable()) worker_.join();
+}
+
+std::shared_ptr<const HormoneHub::Update> HormoneHub::latest() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return latest_;
+}
+
+std::shared_ptr<const HormoneHub::Update> HormoneHub::wait_newer(uint64_t since, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mtx_);
+    ++waiting_;
+    const bool ok = cv_.wait_for(lock, timeout, [&] {
+        return !running_ || (latest_ && latest_->seq > since);
+    });
+    --waiting_;
+    if (!ok || !latest_ || latest_->seq <= since) return nullptr;
+    // neuer Abonnent oder genau ein Update zurück: das fertige Update passt
+    if (since == 0 || latest_->seq == since + 1) return latest_;
+
+    // mehrere übersprungen: letzter Stand, aber die Tokens aller Updates seit `since`
+    std::vector<std::shared_ptr<const Update>> skipped;
+    for (const auto& u : recent_)
+        if (u->seq > since) skipped.push_back(u);
+    lock.unlock();
+
+    const bool gap = skipped.front()->seq > since + 1;
+    auto merged = std::make_shared<Update>(*skipped.back());
+    merged->tokens.clear();
+    for (const auto& u : skipped)
+        merged->tokens.insert(merged->tokens.end(), u->tokens.begin(), u->tokens.end());
+    merged->json = to_json(*merged, gap);
+    return merged;
+}
+
+void HormoneHub::publish(long tick, long spikes, const Hormones& H, std::vector<BrainToken> tokens) {
+    auto u = std::make_shared<Update>();
+    u->tick = tick;
+    u->spikes = spikes;
+    u->hormones = H;
+    u->tokens = std::move(tokens);
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    u->seq = latest_ ? latest_->seq + 1 : 1;
+    u->json = to_json(*u, false);
+    latest_ = std::move(u);
+    recent_.push_back(latest_);
+    if (recent_.size() > kRecentUpdates) recent_.pop_front();
+    cv_.notify_all();   // ein Update, alle Abonnenten
+}
+
+void HormoneHub::poll_tokens(std::vector<BrainToken>& out) {
+    std::error_code ec;
+    const uintmax_t size = std::filesystem::file_size(tokens_path_, ec);
+    if (ec || size == tokens_size_) return;
+    tokens_size_ = size;
+
+    std::vector<BrainToken> all;
+    if (!read_tokens_since(tokens_path_, -1, std::numeric_limits<size_t>::max(), all)) return;
+    // IoLogger kürzt die Datei regelmäßig auf die neuesten Zeilen: das ist kein neuer Lauf.
+    // Neu ist er erst, wenn der neueste Tick hinter dem zuletzt gemeldeten liegt.
+    if (all.empty() || all.back().tick < token_tick_) token_tick_ = -1;
+
+    const auto first = std::find_if(all.begin(), all.end(), [&](const BrainToken& t) { return t.tick > token_tick_; });
+    if (first == all.end()) return;
+    token_tick_ = all.back().tick;
+    out.insert(out.end(), std::make_move_iterator(first), std::make_move_iterator(all.end()));
+}
+
+void HormoneHub::run() {
+    LogTail tail(path_);
+    std::string line;
+
+    // Tokens, die schon vor dem Start in der Datei standen, sind keine Neuigkeit
+    std::vector<BrainToken> pending;
+    poll_tokens(pending);
+    pending.clear();
+
+    while (running_) {
+        Hormones H;
+        long tick = -1, spikes = 0;
+        const bool sample = tail.read_next(line) && parse_hormones(line, H, &tick, &spikes);
+        if (sample && on_sample) on_sample(tick, spikes, H);
+        poll_tokens(pending);
+
+        // nur echte Änderungen weitergeben; Tick-Fortschritt allein ist kein Update
+        const auto last = latest();
+        bool changed = !pending.empty();
+        if (sample)
+            changed = changed || !last || max_delta(last->hormones, H) > epsilon_
+                   || spikes_changed(last->spikes, spikes, spike_delta_);
+        if (!sample && last) {   // nur neue Tokens: letzter Hormonstand bleibt
+            H = last->hormones;
+            tick = last->tick;
+            spikes = last->spikes;
+        }
+        // vor der ersten Hormonzeile gibt es keinen Stand: Tokens bis dahin sammeln
+        if (changed && (sample || last)) {
+            publish(tick, spikes, H, std::move(pending));
+            pending.clear();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(poll_ms_));
+    }
+}
+
+HormoneHub& HormoneHub::shared() {
+    static HormoneHub hub = [] {
+        float eps = 0.01f, spike_delta = 0.5f;
+        if (const char* e = std::getenv("GIZMO_HORMONE_EPSILON")) eps = std::strtof(e, nullptr);
+        if (const char* e = std::getenv("GIZMO_SPIKE_DELTA")) spike_delta = std::strtof(e, nullptr);
+        return HormoneHub("./../brain_core/io/out/spikes.jsonl", "./../brain_core/io/out/tokens.jsonl",
+                          eps, spike_delta, 50);
+    }();
+    return hub;
+}
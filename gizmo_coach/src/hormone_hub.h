@@ -0,0 +1,72 @@
+#pragma once
+#include <string>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "hormons_reader.h"
+#include "tokens_reader.h"
+
+// Ein Watcher-Thread liest spikes.jsonl und tokens.jsonl und veröffentlicht ein kompaktes
+// Update nur bei einer Änderung: ein Hormon um mehr als `epsilon`, die Spike-Zahl um mehr
+// als `spike_delta` (relativ, mind. 5 Spikes) oder neue dekodierte Tokens. Alle Abonnenten
+// (SSE, Long-Poll, get_prompt_context) teilen sich dieses eine Update: kein Datei-Lesen pro Anfrage.
+class HormoneHub {
+public:
+    struct Update {
+        uint64_t    seq = 0;      // steigt mit jedem veröffentlichten Update
+        long        tick = -1;
+        long        spikes = 0;
+        Hormones    hormones;
+        std::vector<BrainToken> tokens;   // seit dem vorigen Update dekodiert (bzw. seit `since`, s. wait_newer)
+        std::string json;         // fertig serialisiert, wird nur einmal erzeugt
+    };
+
+    HormoneHub(std::string path, std::string tokens_path, float epsilon, float spike_delta, int poll_ms);
+    ~HormoneHub();
+
+    void start();
+    void stop();
+
+    std::shared_ptr<const Update> latest() const;
+
+    // wartet auf seq > since; nullptr bei Timeout oder stop(). Liegt `since` mehr als ein Update
+    // zurück, kommt der letzte Stand mit den Tokens aller Updates danach (aus einem Ring der
+    // letzten 256 Updates; reicht der nicht, steht "gap": true im JSON)
+    std::shared_ptr<const Update> wait_newer(uint64_t since, std::chrono::milliseconds timeout);
+
+    // jede gelesene Zeile, auch ohne Änderung > epsilon (z. B. für die Historie); vor start() setzen
+    std::function<void(long tick, long spikes, const Hormones&)> on_sample;
+
+    float epsilon() const { return epsilon_; }
+    int   waiting() const { return waiting_; }
+
+    // ../brain_core/io/out/spikes.jsonl + tokens.jsonl, epsilon aus GIZMO_HORMONE_EPSILON
+    // (Default 0.01), spike_delta aus GIZMO_SPIKE_DELTA (Default 0.5)
+    static HormoneHub& shared();
+
+private:
+    void run();
+    void poll_tokens(std::vector<BrainToken>& out);
+    void publish(long tick, long spikes, const Hormones& H, std::vector<BrainToken> tokens);
+
+    std::string path_, tokens_path_;
+    float epsilon_, spike_delta_;
+    int   poll_ms_;
+    uintmax_t tokens_size_ = 0;     // tokens.jsonl nur neu lesen, wenn sich die Größe ändert
+    long      token_tick_  = -1;    // letzter gemeldeter Token-Tick
+
+    mutable std::mutex mtx_;
+    std::condition_variable cv_;
+    std::shared_ptr<const Update> latest_;
+    std::deque<std::shared_ptr<const Update>> recent_;   // die letzten Updates, latest_ zuletzt
+    std::atomic<bool> running_{false};
+    std::atomic<int>  waiting_{0};
+    std::thread worker_;
+};
@@ -2,15 +2,8 @@
 #include <fstream>
 #include <nlohmann/json.hpp>
 
-bool read_latest_hormones(const std::string& spikes_path, Hormones& H) {
-    std::ifstream f(spikes_path);
-    if (!f.is_open()) return false;
-
-    std::string line, last;
-    while (std::getline(f, line)) if (!line.empty()) last = std::move(line);
-    if (last.empty()) return false;
-
-    auto j = nlohmann::json::parse(last, nullptr, false);
+bool parse_hormones(const std::string& line, Hormones& H, long* tick, long* spikes) {
+    auto j = nlohmann::json::parse(line, nullptr, false);
     if (j.is_discarded() || j.value("type","") != "spike" || !j.contains("hormones")) return false;
 
     const auto& h = j["hormones"];
@@ -26,5 +19,18 @@ bool read_latest_hormones(const std::string& spikes_path, Hormones& H) {
     H.endorphin     = to_f("endorphin");
     H.acetylcholine = to_f("acetylcholine");
     H.testosterone  = to_f("testosterone");
+    if (tick)   *tick   = j.value("timestep", -1L);
+    if (spikes) *spikes = j.value("spikes", 0L);
     return true;
 }
+
+bool read_latest_hormones(const std::string& spikes_path, Hormones& H) {
+    std::ifstream f(spikes_path);
+    if (!f.is_open()) return false;
+
+    std::string line, last;
+    while (std::getline(f, line)) if (!line.empty()) last = std::move(line);
+    if (last.empty()) return false;
+
+    return parse_hormones(last, H);
+}
@@ -6,4 +6,6 @@ struct Hormones {
           melatonin=0, noradrenaline=0, endorphin=0, acetylcholine=0, testosterone=0;
 };
 
+// eine Zeile aus spikes.jsonl (type "spike"); tick/spikes optional
+bool parse_hormones(const std::string& line, Hormones& H, long* tick = nullptr, long* spikes = nullptr);
 bool read_latest_hormones(const std::string& spikes_path, Hormones& H);
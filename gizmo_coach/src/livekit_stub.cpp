@@ -2,10 +2,19 @@
 #include "coach_logic.h"
 #include "hormons_reader.h"
 #include "brain_io.h"
+#include "tokens_reader.h"
+#include "pattern_gen.h"
+#include "sdr_encoder.h"
+#include "hormone_hub.h"
+#include "feedback_coalescer.h"
+#include "hormone_history.h"
 
 #include <nlohmann/json.hpp>
 #include <httplib.h>
 #include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
 
 using json = nlohmann::json;
 using namespace httplib;
@@ -23,8 +32,11 @@ json process_request(const json& msg) {
     try {
         std::string method = msg.value("method", "");
         if (method == "get_prompt_context") {
+            // letzter Stand aus dem Hub, Datei nur solange der Watcher noch nichts gesehen hat
             Hormones H;
-            if (!read_latest_hormones("./../brain_core/io/out/spikes.jsonl", H)) {
+            const auto cur = HormoneHub::shared().latest();
+            if (cur) H = cur->hormones;
+            if (!cur && !read_latest_hormones("./../brain_core/io/out/spikes.jsonl", H)) {
                 reply["error"] = { {"message", "Fehler beim Lesen der Hormonwerte"} };
             } else {
                 std::string prompt = build_prompt();
@@ -49,8 +61,106 @@ json process_request(const json& msg) {
             Decision d;
             d.feedback = msg["params"].value("feedback", "none");
             d.intensity = msg["params"].value("intensity", 0.0f);
-            apply_feedback("./../brain_core/io/in/commands.jsonl", d);
-            reply["result"] = { {"status", "ok"} };
+            // gesammelt: höchstens ein set_hormones pro Fenster
+            FeedbackCoalescer::shared().submit(d);
+            reply["result"] = { {"status", "queued"} };
+        }
+        else if (method == "get_tokens") {
+            // params: since (Tick, exklusiv), limit
+            const json params = msg.value("params", json::object());
+            const long   since = params.value("since", -1L);
+            const size_t limit = params.value("limit", 64);
+
+            std::vector<BrainToken> tokens;
+            bool more = false;
+            if (!read_tokens_since("./../brain_core/io/out/tokens.jsonl", since, limit, tokens, &more)) {
+                reply["error"] = { {"message", "Fehler beim Lesen der Tokens"} };
+            } else {
+                json arr = json::array();
+                std::string text;
+                for (const auto& t : tokens) {
+                    arr.push_back({ {"tick", t.tick}, {"token", t.token}, {"output", t.output}, {"count", t.count} });
+                    text += t.token;
+                }
+                reply["result"] = {
+                    {"tokens", arr},
+                    {"text", text},
+                    {"last_tick", tokens.empty() ? since : tokens.back().tick},
+                    {"more", more}
+                };
+            }
+        }
+        else if (method == "send_text") {
+            // params: text, mode (words|ngrams), ngram, n_inputs, active_bits, ticks_per_token, amplitude
+            const json params = msg.value("params", json::object());
+            const std::string text = params.value("text", "");
+            const int n_inputs = params.value("n_inputs", 10);
+            const int k = params.value("active_bits", sdr_active_bits(n_inputs));
+            const int ticks = std::max(1, params.value("ticks_per_token", 20));
+            const float amp = params.value("amplitude", 1.0f);
+            const auto mode = parse_sdr_mode(params.value("mode", "words"));
+
+            auto& enc = SdrEncoder::shared();
+            const auto steps = enc.encode_sequence(text, n_inputs, k, mode, params.value("ngram", 3));
+            if (steps.empty()) {
+                reply["error"] = { {"message", "Text enthält keine Tokens"} };
+            } else {
+                send_input_sequence("./../brain_core/io/in/commands.jsonl", steps, ticks, amp);
+
+                json arr = json::array();
+                for (const auto& s : steps) arr.push_back({ {"token", s.token}, {"bits", s.bits} });
+                const auto st = enc.stats();
+                reply["result"] = {
+                    {"steps", arr},
+                    {"ticks", static_cast<long>(steps.size()) * ticks},
+                    {"cache", { {"hits", st.hits}, {"misses", st.misses}, {"size", st.size}, {"capacity", st.capacity} }}
+                };
+            }
+        }
+        else if (method == "score_replies") {
+            // params: texts (Liste) oder text, apply (Feedback des letzten Texts ans Gehirn)
+            const json params = msg.value("params", json::object());
+            std::vector<std::string> texts;
+            if (params.contains("texts")) texts = params["texts"].get<std::vector<std::string>>();
+            else texts.push_back(params.value("text", ""));
+
+            const auto decisions = parse_decisions(texts);
+            json arr = json::array();
+            for (const auto& d : decisions)
+                arr.push_back({ {"feedback", d.feedback}, {"intensity", d.intensity} });
+            if (params.value("apply", false) && !decisions.empty())
+                FeedbackCoalescer::shared().submit(decisions.back());
+            reply["result"] = { {"decisions", arr} };
+        }
+        else if (method == "get_trend") {
+            // params: window_s (Default 60), channels (Default alle), threshold (|slope| pro Minute für rising/falling)
+            const json params = msg.value("params", json::object());
+            const double window_s = params.value("window_s", 60.0);
+            const float threshold = params.value("threshold", 0.05f);
+
+            std::vector<int> chans;
+            if (params.contains("channels")) {
+                for (const auto& name : params["channels"]) {
+                    const int c = HormoneHistory::channel(name.get<std::string>());
+                    if (c < 0) throw std::runtime_error("Unbekannter Kanal: " + name.get<std::string>());
+                    chans.push_back(c);
+                }
+            } else {
+                for (int c = 0; c < HormoneHistory::kChannels; ++c) chans.push_back(c);
+            }
+
+            const auto w = HormoneHistory::shared().query(static_cast<int64_t>(window_s * 1000.0));
+            json out = json::object();
+            for (int c : chans) {
+                const auto& s = w.ch[c];
+                const float per_min = s.slope * 60.0f;
+                out[HormoneHistory::kNames[c]] = {
+                    {"mean", s.mean}, {"min", s.min}, {"max", s.max}, {"first", s.first}, {"last", s.last},
+                    {"slope_per_min", per_min},
+                    {"trend", w.buckets < 2 ? "unknown" : per_min > threshold ? "rising" : per_min < -threshold ? "falling" : "stable"}
+                };
+            }
+            reply["result"] = { {"window_s", window_s}, {"resolution_ms", w.resolution_ms}, {"buckets", w.buckets}, {"channels", out} };
         }
         else {
             reply["error"] = { {"message", "Unbekannte Methode"} };
@@ -93,6 +203,70 @@ void handle_from_livekit(const std::string&) {
         }
     });
 
+    // Hormon-Stream: ein Watcher, beliebig viele Abonnenten
+    auto& hub = HormoneHub::shared();
+    hub.on_sample = [](long, long spikes, const Hormones& H) {
+        HormoneHistory::shared().add(H, static_cast<float>(spikes));
+    };
+    hub.start();
+
+    // jede offene SSE-/Long-Poll-Verbindung belegt einen Worker: eigener Server mit eigenem Pool,
+    // damit volle Streams nie die MCP-Anfragen auf 5001 aushungern. Mehr als GIZMO_STREAM_MAX
+    // (Default 64) Abonnenten warten in der Queue, bis ein Platz frei wird.
+    int stream_port = 5002, stream_max = 64;
+    if (const char* e = std::getenv("GIZMO_STREAM_PORT")) stream_port = std::atoi(e);
+    if (const char* e = std::getenv("GIZMO_STREAM_MAX")) stream_max = std::max(1, std::atoi(e));
+    Server streams;
+    streams.new_task_queue = [stream_max] { return new ThreadPool(static_cast<size_t>(stream_max)); };
+
+    // Long-Poll: GET /hormones?since=<seq>&timeout_ms=<ms>, alternativ If-None-Match: "<seq>"
+    streams.Get("/hormones", [&hub](const Request& req, Response& res) {
+        uint64_t since = 0;
+        if (req.has_param("since")) since = std::stoull(req.get_param_value("since"));
+        else if (req.has_header("If-None-Match")) {
+            std::string tag = req.get_header_value("If-None-Match");
+            tag.erase(std::remove(tag.begin(), tag.end(), '"'), tag.end());
+            if (!tag.empty()) since = std::stoull(tag);
+        }
+        const long timeout_ms = req.has_param("timeout_ms") ? std::stol(req.get_param_value("timeout_ms")) : 25000;
+
+        auto u = hub.wait_newer(since, std::chrono::milliseconds(std::clamp(timeout_ms, 0L, 60000L)));
+        if (!u) {
+            res.status = 304;   // nichts Neues, ETag bleibt
+            res.set_header("ETag", "\"" + std::to_string(since) + "\"");
+            return;
+        }
+        res.set_header("ETag", "\"" + std::to_string(u->seq) + "\"");
+        res.set_content(u->json, "application/json");
+    });
+
+    // Server-Sent Events: GET /hormones/stream, Wiederaufnahme über Last-Event-ID
+    streams.Get("/hormones/stream", [&hub](const Request& req, Response& res) {
+        auto last = std::make_shared<uint64_t>(0);
+        if (req.has_header("Last-Event-ID")) *last = std::stoull(req.get_header_value("Last-Event-ID"));
+
+        res.set_header("Cache-Control", "no-cache");
+        res.set_chunked_content_provider("text/event-stream", [&hub, last](size_t, DataSink& sink) {
+            auto u = hub.wait_newer(*last, std::chrono::seconds(15));
+            std::string msg;
+            if (u) {
+                *last = u->seq;
+                msg = "id: " + std::to_string(u->seq) + "\nevent: hormones\ndata: " + u->json + "\n\n";
+            } else {
+                msg = ": ping\n\n";   // Keepalive, erkennt getrennte Clients
+            }
+            return sink.is_writable() && sink.write(msg.data(), msg.size());
+        });
+    });
+
+    auto& fb = FeedbackCoalescer::shared();
+    std::cout << "[LiveKit] 🎚️ Feedback-Fenster " << fb.window_ms() << " ms\n";
     std::cout << "[LiveKit] MCP-Server läuft auf http://localhost:5001\n";
+    std::cout << "[LiveKit] 📡 Hormon-Stream auf http://localhost:" << stream_port
+              << ": /hormones (Long-Poll), /hormones/stream (SSE), max. " << stream_max
+              << " Abonnenten, epsilon " << hub.epsilon() << "\n";
+    std::thread stream_thread([&streams, stream_port] { streams.listen("0.0.0.0", stream_port); });
     svr.listen("0.0.0.0", 5001);
+    streams.stop();
+    stream_thread.join();
 }
\ No newline at end of file
@@ -1,14 +1,16 @@
 #include "pattern_gen.h"
-#include <random>
+#include "sdr_encoder.h"
 #include <algorithm>
 
+int sdr_active_bits(int n_inputs) {
+    return std::clamp(n_inputs / 20, std::min(2, n_inputs), std::max(1, n_inputs));
+}
+
 std::vector<int> text_to_pattern(const std::string& text, int n_inputs) {
     std::vector<int> pat(n_inputs, 0);
-    std::seed_seq seed(text.begin(), text.end());
-    std::mt19937 rng(seed);
-    float density = std::clamp(0.10f + 0.15f*(text.size()/100.0f), 0.05f, 0.35f);
-    std::uniform_real_distribution<float> U(0.0f, 1.0f);
-    for (int i=0; i<n_inputs; i++)
-        pat[i] = (U(rng) < density) ? 1 : 0;
+    const auto steps = SdrEncoder::shared().encode_sequence(text, n_inputs, sdr_active_bits(n_inputs),
+                                                            SdrEncoder::Mode::Words);
+    for (const auto& s : steps)
+        for (int b : s.bits) pat[b] = 1;
     return pat;
 }
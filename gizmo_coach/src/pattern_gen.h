@@ -2,4 +2,8 @@
 #include <string>
 #include <vector>
 
+// aktive Bits pro Token bei n Inputs (~5 %, mindestens 2)
+int sdr_active_bits(int n_inputs);
+
+// ganzer Text als ein 0/1-Muster: Vereinigung der Wort-SDRs (für input_pattern)
 std::vector<int> text_to_pattern(const std::string& text, int n_inputs);
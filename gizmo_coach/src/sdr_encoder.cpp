@@ -0,0 +1,129 @@
+#include "sdr_encoder.h"
+#include <algorithm>
+#include <cctype>
+#include <unordered_set>
+#include <stdexcept>
+
+namespace {
+
+uint64_t fnv1a(const std::string& s) {
+    uint64_t h = 1469598103934665603ull;
+    for (unsigned char c : s) { h ^= c; h *= 1099511628211ull; }
+    return h;
+}
+
+// kleiner, schneller Zahlenstrom aus einem 64-Bit-Zustand (statt seed_seq + mt19937 pro Aufruf)
+uint64_t splitmix64(uint64_t& x) {
+    uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// k verschiedene Indizes aus [0, n), Floyd-Sampling: genau k Zufallszahlen
+std::vector<int> sample_bits(uint64_t seed, int n, int k) {
+    std::vector<int> out;
+    out.reserve(k);
+    std::unordered_set<int> taken;
+    for (int j = n - k; j < n; ++j) {
+        const int t = static_cast<int>(splitmix64(seed) % static_cast<uint64_t>(j + 1));
+        const int pick = taken.count(t) ? j : t;
+        taken.insert(pick);
+        out.push_back(pick);
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+bool is_word_char(unsigned char c) {
+    return c >= 0x80 || std::isalnum(c);   // UTF-8-Folgebytes gehören zum Wort
+}
+
+} // namespace
+
+std::vector<std::string> SdrEncoder::tokenize(const std::string& text, Mode mode, int ngram) {
+    // 1️⃣ Wörter (ASCII klein, UTF-8 unverändert)
+    std::vector<std::string> words;
+    std::string cur;
+    for (unsigned char c : text) {
+        if (is_word_char(c)) {
+            cur += static_cast<char>(c < 0x80 ? std::tolower(c) : c);
+        } else if (!cur.empty()) {
+            words.push_back(cur);
+            cur.clear();
+        }
+    }
+    if (!cur.empty()) words.push_back(cur);
+    if (mode == Mode::Words) return words;
+
+    // 2️⃣ Zeichen-n-Gramme pro Wort, mit Randmarken: "hallo" -> "_ha", "hal", ..., "lo_"
+    std::vector<std::string> grams;
+    for (const auto& w : words) {
+        const std::string padded = "_" + w + "_";
+        if (static_cast<int>(padded.size()) <= ngram) {
+            grams.push_back(padded);
+            continue;
+        }
+        for (size_t i = 0; i + ngram <= padded.size(); ++i)
+            grams.push_back(padded.substr(i, ngram));
+    }
+    return grams;
+}
+
+std::vector<int> SdrEncoder::encode_token(const std::string& token, int n, int k) {
+    if (n <= 0) throw std::runtime_error("SDR: n muss > 0 sein");
+    k = std::clamp(k, 1, n);
+    const std::string key = std::to_string(n) + ':' + std::to_string(k) + ':' + token;
+
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        auto it = index_.find(key);
+        if (it != index_.end()) {
+            lru_.splice(lru_.begin(), lru_, it->second);   // nach vorne, O(1)
+            ++hits_;
+            return it->second->second;
+        }
+        ++misses_;
+    }
+
+    // außerhalb des Locks rechnen; zwei gleichzeitige Misses liefern dasselbe Ergebnis
+    std::vector<int> bits = sample_bits(fnv1a(token), n, k);
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (!index_.count(key)) {
+        lru_.emplace_front(key, bits);
+        index_[key] = lru_.begin();
+        if (lru_.size() > capacity_) {
+            index_.erase(lru_.back().first);
+            lru_.pop_back();
+        }
+    }
+    return bits;
+}
+
+std::vector<SdrEncoder::Step> SdrEncoder::encode_sequence(const std::string& text, int n, int k, Mode mode, int ngram) {
+    std::vector<Step> steps;
+    for (auto& tok : tokenize(text, mode, ngram)) {
+        Step s;
+        s.bits = encode_token(tok, n, k);
+        s.token = std::move(tok);
+        steps.push_back(std::move(s));
+    }
+    return steps;
+}
+
+SdrEncoder::Stats SdrEncoder::stats() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return { hits_, misses_, lru_.size(), capacity_ };
+}
+
+SdrEncoder& SdrEncoder::shared() {
+    static SdrEncoder enc;
+    return enc;
+}
+
+SdrEncoder::Mode parse_sdr_mode(const std::string& s) {
+    if (s == "words") return SdrEncoder::Mode::Words;
+    if (s == "ngrams") return SdrEncoder::Mode::NGrams;
+    throw std::runtime_error("Unbekannter SDR-Modus: " + s + " (words|ngrams)");
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+// Text -> zeitliche Folge dünn besetzter Muster (Sparse Distributed Representation).
+//
+//  - Text wird in Tokens zerlegt: Wörter oder Zeichen-n-Gramme.
+//  - Jedes Token bekommt k aktive Bits von n, deterministisch aus einem Hash des Tokens
+//    (gleiches Token -> gleiches Muster, verschiedene Tokens überlappen kaum).
+//  - Ergebnisse liegen in einem thread-sicheren LRU-Cache: wiederkehrendes Vokabular
+//    kostet nur noch einen Lookup.
+class SdrEncoder {
+public:
+    enum class Mode { Words, NGrams };
+
+    struct Step {
+        std::string token;
+        std::vector<int> bits;   // aktive Indizes in [0, n), aufsteigend
+    };
+
+    struct Stats {
+        size_t hits = 0, misses = 0, size = 0, capacity = 0;
+    };
+
+    explicit SdrEncoder(size_t capacity = 4096) : capacity_(capacity) {}
+
+    // Tokens in Lesereihenfolge (Kleinbuchstaben, ASCII-Satzzeichen trennen)
+    static std::vector<std::string> tokenize(const std::string& text, Mode mode, int ngram = 3);
+
+    // k aktive Bits von n für ein Token (aus dem Cache oder neu berechnet)
+    std::vector<int> encode_token(const std::string& token, int n, int k);
+
+    // ein Schritt pro Token
+    std::vector<Step> encode_sequence(const std::string& text, int n, int k, Mode mode, int ngram = 3);
+
+    Stats stats() const;
+
+    static SdrEncoder& shared();   // gemeinsame Instanz für alle Requests
+
+private:
+    using Entry = std::pair<std::string, std::vector<int>>;
+
+    size_t capacity_;
+    mutable std::mutex mtx_;
+    std::list<Entry> lru_;       // vorne = zuletzt benutzt
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+    size_t hits_ = 0, misses_ = 0;
+};
+
+SdrEncoder::Mode parse_sdr_mode(const std::string& s);
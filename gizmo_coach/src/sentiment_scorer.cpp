@@ -0,0 +1,270 @@
+#include "sentiment_scorer.h"
+#include <fstream>
+#include <deque>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <iostream>
+#include <nlohmann/json.hpp>
+
+namespace {
+
+// ein Codepoint ab s[i], i wird weitergeschoben; ungültige Bytes -> -1 (werden unverändert übernommen)
+int32_t decode(const std::string& s, size_t& i) {
+    const unsigned char c = s[i];
+    int len = 0;
+    int32_t cp = 0;
+    if (c < 0x80)                { ++i; return c; }
+    else if ((c & 0xE0) == 0xC0) { len = 2; cp = c & 0x1F; }
+    else if ((c & 0xF0) == 0xE0) { len = 3; cp = c & 0x0F; }
+    else if ((c & 0xF8) == 0xF0) { len = 4; cp = c & 0x07; }
+    else                         { return -1; }
+    if (i + len > s.size()) return -1;
+    for (int k = 1; k < len; ++k) {
+        const unsigned char t = s[i + k];
+        if ((t & 0xC0) != 0x80) return -1;
+        cp = (cp << 6) | (t & 0x3F);
+    }
+    i += len;
+    return cp;
+}
+
+void encode(int32_t cp, std::string& out) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+// einfache Kleinschreibung (1:1-Abbildung, keine Längenänderung in Codepoints)
+int32_t lower(int32_t cp) {
+    if (cp < 0x80) return (cp >= 'A' && cp <= 'Z') ? cp + 32 : cp;
+
+    // Latin-1: À..Þ außer ×
+    if (cp >= 0xC0 && cp <= 0xDE && cp != 0xD7) return cp + 32;
+
+    // Latin Extended-A: Groß/Klein abwechselnd, mit Verschiebung bei Ĺ..Ň und Ź..Ž
+    if (cp >= 0x0100 && cp <= 0x017F) {
+        if (cp == 0x0130) return 'i';          // İ
+        if (cp == 0x0178) return 0xFF;         // Ÿ
+        if (cp == 0x017F) return 's';          // ſ
+        const bool even = (cp % 2) == 0;
+        if ((cp <= 0x012F || (cp >= 0x0132 && cp <= 0x0137) || (cp >= 0x014A && cp <= 0x0177)) && even)
+            return cp + 1;
+        if (((cp >= 0x0139 && cp <= 0x0148) || (cp >= 0x0179 && cp <= 0x017E)) && !even)
+            return cp + 1;
+        return cp;
+    }
+    if (cp == 0x1E9E) return 0xDF;             // ẞ -> ß
+
+    // Griechisch
+    if (cp >= 0x0391 && cp <= 0x03A9 && cp != 0x03A2) return cp + 32;
+    if (cp == 0x0386) return 0x03AC;
+    if (cp >= 0x0388 && cp <= 0x038A) return cp + 37;
+    if (cp == 0x038C) return 0x03CC;
+    if (cp == 0x038E || cp == 0x038F) return cp + 63;
+    if (cp == 0x03C2) return 0x03C3;           // Schluss-Sigma wie σ
+
+    // Kyrillisch
+    if (cp >= 0x0410 && cp <= 0x042F) return cp + 32;
+    if (cp >= 0x0400 && cp <= 0x040F) return cp + 80;
+
+    return cp;
+}
+
+// Eingebautes Lexikon (entspricht den früheren Listen in parse_decision)
+const char* const kPositive[] = {
+    "gut","freue","danke","toll","super","gern","wunderbar","zufrieden","happy",
+    "glücklich","schön","lieb","love","mag","nice","yay","ok","okay"
+};
+const char* const kNegative[] = {
+    "schlecht","nicht gut","traurig","hasse","angst","doof","wütend","böse",
+    "nein","fail","fehler","müde","stress","sorge","nervt","schlimm","negativ","kaputt"
+};
+// Emoji-Gruppen: früher je eine Oder-Abfrage, also +1 / -1 pro Text, egal wie viele davon
+const char* const kPositiveEmoji[] = { "😊", ":)" };
+const char* const kNegativeEmoji[] = { "😡", "☹️" };
+
+void add_group(SentimentScorer& s, const nlohmann::json& words, float weight) {
+    if (!words.is_array()) throw std::runtime_error("Sentiment-Lexikon: Gruppe muss eine Liste sein");
+    const int g = s.new_group();
+    for (const auto& w : words) s.add(w.get<std::string>(), weight, g);
+}
+
+void load_side(SentimentScorer& s, const nlohmann::json& j, float sign) {
+    if (j.is_array()) {
+        for (const auto& w : j) {
+            if (w.is_array()) add_group(s, w, sign);
+            else s.add(w.get<std::string>(), sign);
+        }
+    } else if (j.is_object()) {
+        for (auto it = j.begin(); it != j.end(); ++it) {
+            const auto& v = it.value();
+            if (v.is_object())
+                add_group(s, v.value("any", nlohmann::json()), sign * std::abs(v.value("weight", 1.0f)));
+            else
+                s.add(it.key(), sign * std::abs(v.get<float>()));
+        }
+    } else if (!j.is_null()) {
+        throw std::runtime_error("Sentiment-Lexikon: positive/negative muss Liste oder Objekt sein");
+    }
+}
+
+} // namespace
+
+std::string SentimentScorer::fold(const std::string& utf8) {
+    std::string out;
+    out.reserve(utf8.size());
+    for (size_t i = 0; i < utf8.size(); ) {
+        const size_t at = i;
+        const int32_t cp = decode(utf8, i);
+        if (cp < 0) {                  // kaputtes UTF-8: Byte durchreichen
+            out += utf8[at];
+            i = at + 1;
+            continue;
+        }
+        encode(lower(cp), out);
+    }
+    return out;
+}
+
+void SentimentScorer::add(const std::string& pattern, float weight, int group) {
+    std::string p = fold(pattern);
+    if (p.empty()) return;
+    pending_.push_back(std::move(p));
+    weights_.push_back(weight);
+    group_.push_back(group >= 0 ? group : new_group());
+    nodes_.clear();                    // neu kompilieren
+}
+
+void SentimentScorer::load(const std::string& path) {
+    std::ifstream f(path);
+    if (!f) throw std::runtime_error("Sentiment-Lexikon nicht lesbar: " + path);
+    nlohmann::json j = nlohmann::json::parse(f);
+    load_side(*this, j.value("positive", nlohmann::json()), +1.0f);
+    load_side(*this, j.value("negative", nlohmann::json()), -1.0f);
+}
+
+void SentimentScorer::load_defaults() {
+    for (const char* w : kPositive) add(w, +1.0f);
+    for (const char* w : kNegative) add(w, -1.0f);
+    const int pos = new_group(), neg = new_group();
+    for (const char* w : kPositiveEmoji) add(w, +1.0f, pos);
+    for (const char* w : kNegativeEmoji) add(w, -1.0f, neg);
+}
+
+void SentimentScorer::compile() {
+    // 1️⃣ Trie über die normalisierten Bytes
+    nodes_.assign(1, Node{});
+    std::fill(std::begin(nodes_[0].next), std::end(nodes_[0].next), -1);
+    out_next_.assign(pending_.size(), -1);
+
+    for (size_t p = 0; p < pending_.size(); ++p) {
+        int cur = 0;
+        for (unsigned char c : pending_[p]) {
+            if (nodes_[cur].next[c] < 0) {
+                nodes_[cur].next[c] = static_cast<int>(nodes_.size());
+                nodes_.emplace_back();
+                std::fill(std::begin(nodes_.back().next), std::end(nodes_.back().next), -1);
+            }
+            cur = nodes_[cur].next[c];
+        }
+        out_next_[p] = nodes_[cur].out;   // doppelte Muster: beide behalten
+        nodes_[cur].out = static_cast<int>(p);
+    }
+
+    // 2️⃣ Fehlerlinks per BFS, fehlende Übergänge direkt auffüllen (vollständiger DFA)
+    std::deque<int> queue;
+    for (int c = 0; c < 256; ++c) {
+        int& nx = nodes_[0].next[c];
+        if (nx < 0) nx = 0;
+        else { nodes_[nx].fail = 0; queue.push_back(nx); }
+    }
+    while (!queue.empty()) {
+        const int u = queue.front();
+        queue.pop_front();
+        // Ausgabekette: Treffer des Fehlerknotens hinten anhängen
+        if (nodes_[u].out < 0) {
+            nodes_[u].out = nodes_[nodes_[u].fail].out;
+        } else {
+            int last = nodes_[u].out;
+            while (out_next_[last] >= 0) last = out_next_[last];
+            if (last != nodes_[nodes_[u].fail].out) out_next_[last] = nodes_[nodes_[u].fail].out;
+        }
+        for (int c = 0; c < 256; ++c) {
+            int& nx = nodes_[u].next[c];
+            const int via = nodes_[nodes_[u].fail].next[c];
+            if (nx < 0) { nx = via; }
+            else { nodes_[nx].fail = via; queue.push_back(nx); }
+        }
+    }
+}
+
+SentimentScore SentimentScorer::score(const std::string& text) const {
+    if (nodes_.empty()) throw std::runtime_error("SentimentScorer: compile() fehlt");
+
+    SentimentScore r;
+    std::vector<char> seen(groups_, 0);   // pro Gruppe, Einzeleinträge haben eine eigene
+    std::string buf;                   // ein normalisierter Codepoint
+
+    // ein Durchgang: dekodieren, falten, Automat weiterschalten, Satzzeichen zählen
+    int state = 0;
+    for (size_t i = 0; i < text.size(); ) {
+        const size_t at = i;
+        const int32_t cp = decode(text, i);
+        buf.clear();
+        if (cp < 0) { buf += text[at]; i = at + 1; }
+        else        encode(lower(cp), buf);
+
+        if (cp == '!') ++r.exclaim;
+        else if (cp == '?') ++r.question;
+
+        for (unsigned char c : buf) {
+            state = nodes_[state].next[c];
+            for (int p = nodes_[state].out; p >= 0; p = out_next_[p]) {
+                if (seen[group_[p]]) continue;
+                seen[group_[p]] = 1;
+                r.score += weights_[p];
+                if (weights_[p] > 0) ++r.positive;
+                else if (weights_[p] < 0) ++r.negative;
+            }
+        }
+    }
+    return r;
+}
+
+std::vector<SentimentScore> SentimentScorer::score_batch(const std::vector<std::string>& texts) const {
+    std::vector<SentimentScore> out;
+    out.reserve(texts.size());
+    for (const auto& t : texts) out.push_back(score(t));
+    return out;
+}
+
+const SentimentScorer& SentimentScorer::shared() {
+    static const SentimentScorer s = [] {
+        SentimentScorer sc;
+        const std::string path = "./config/sentiment.json";
+        try {
+            sc.load(path);
+            std::cout << "💬 Sentiment-Lexikon geladen: " << path << "\n";
+        } catch (const std::exception& e) {
+            sc = SentimentScorer();
+            sc.load_defaults();
+            std::cout << "💬 Sentiment-Lexikon: eingebaut (" << e.what() << ")\n";
+        }
+        sc.compile();
+        return sc;
+    }();
+    return s;
+}
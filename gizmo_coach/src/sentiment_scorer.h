@@ -0,0 +1,57 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Ergebnis für einen Text
+struct SentimentScore {
+    float score    = 0.0f;   // Summe der Gewichte aller gefundenen Lexikon-Einträge
+    int   positive = 0;      // gefundene Einträge mit Gewicht > 0
+    int   negative = 0;      // ... mit Gewicht < 0
+    int   exclaim  = 0;      // Anzahl '!'
+    int   question = 0;      // Anzahl '?'
+};
+
+// Lexikon-Scorer: alle Wörter/Emojis in einem Aho-Corasick-Automaten, der Text wird
+// in einem Durchgang gelesen (O(Textlänge + Treffer) statt O(Wörter × Textlänge)).
+// Muster und Text werden gleich normalisiert: UTF-8-Kleinschreibung inkl. Umlaute,
+// ẞ, Latin Extended-A, Griechisch und Kyrillisch. Jeder Eintrag zählt pro Text
+// höchstens einmal (wie früher text.find pro Wort); Einträge einer Gruppe (z.B. "😊"
+// und ":)") zählen zusammen nur einmal, wie früher die Oder-Abfragen für Emojis.
+class SentimentScorer {
+public:
+    // group < 0: eigener Eintrag; sonst zählt die Gruppe (aus new_group) pro Text einmal
+    void add(const std::string& pattern, float weight, int group = -1);
+    int  new_group() { return groups_++; }
+    // JSON: {"positive": {"gut": 1.0, "smiley": {"any": ["😊", ":)"], "weight": 1.0}, ...}
+    //                  | ["gut", ["😊", ":)"], ...], "negative": {...} | [...]}
+    // Listen bekommen Gewicht +1 / -1, negative Gewichte in "negative" werden als Betrag genommen.
+    // Unterlisten bzw. {"any": [...]} bilden eine Gruppe.
+    void load(const std::string& path);
+    void load_defaults();
+    void compile();          // nach add/load, vor score
+
+    SentimentScore score(const std::string& text) const;
+    std::vector<SentimentScore> score_batch(const std::vector<std::string>& texts) const;
+
+    size_t patterns() const { return weights_.size(); }
+
+    // gemeinsame Instanz: config/sentiment.json, sonst eingebautes Lexikon
+    static const SentimentScorer& shared();
+
+    static std::string fold(const std::string& utf8);   // UTF-8-Kleinschreibung
+
+private:
+    struct Node {
+        int next[256];
+        int fail = 0;
+        int out = -1;        // erstes Muster, das hier endet (Kette über out_next_)
+    };
+
+    std::vector<std::string> pending_;   // normalisierte Muster vor compile()
+    std::vector<float> weights_;
+    std::vector<int>   group_;           // Zählslot pro Muster (gemeinsam innerhalb einer Gruppe)
+    int                groups_ = 0;
+    std::vector<int>   out_next_;        // weitere Muster mit demselben Suffix-Ende
+    std::vector<Node>  nodes_;
+};
@@ -0,0 +1,32 @@
+#include "tokens_reader.h"
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+bool read_tokens_since(const std::string& tokens_path, long since_tick, size_t limit, std::vector<BrainToken>& out,
+                       bool* more) {
+    std::ifstream f(tokens_path);
+    if (!f.is_open()) return false;
+
+    out.clear();
+    if (more) *more = false;
+    std::string line;
+    while (std::getline(f, line)) {
+        if (line.empty()) continue;
+        auto j = nlohmann::json::parse(line, nullptr, false);
+        if (j.is_discarded() || j.value("type", "") != "token") continue;
+
+        BrainToken t;
+        t.tick = j.value("timestep", 0L);
+        if (t.tick <= since_tick) continue;
+        // voll: nur noch Tokens desselben Ticks, damit last_tick als nächstes since nichts verliert
+        if (out.size() >= limit && (out.empty() || t.tick != out.back().tick)) {
+            if (more) *more = true;
+            break;
+        }
+        t.token  = j.value("token", "");
+        t.output = j.value("output", 0);
+        t.count  = j.value("count", 0);
+        out.push_back(std::move(t));
+    }
+    return true;
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include <string>
+#include <vector>
+
+struct BrainToken {
+    long tick = 0;
+    std::string token;
+    int output = 0;
+    int count = 0;
+};
+
+// Liest dekodierte Tokens aus tokens.jsonl mit tick > since_tick, die ältesten zuerst: höchstens
+// limit, ein angefangener Tick aber immer ganz (sonst überspringt since = letzter Tick den Rest).
+// more: danach stehen noch weitere Tokens in der Datei
+bool read_tokens_since(const std::string& tokens_path, long since_tick, size_t limit, std::vector<BrainToken>& out,
+                       bool* more = nullptr);